@@ -3,19 +3,63 @@
 #include "app_init.h"
 #include "scale_manager.h"
 #include "key_handler.h"
+#include "batch_controller.h"
+#include "event_queue.h"
+#include "power_manager.h"
+#include "clock_manager.h"
+#include "debug_uart.h"
+#include "debug_console.h"
+#include "profiler.h"
+#include "mem_monitor.h"
+#include "supervisor.h"
 
 static WeightSensor_InitTypeDef WeightSensor_InitStruct;
 static Buzzer_InitTypeDef Buzzer_InitStruct;
+#if DISPLAY_TYPE == DISPLAY_LED_SEG
+extern const uint8_t LED_BRIGHTNESS_ACTIVE;
+static LedSeg_InitTypeDef LedSeg_InitStruct;
+#elif DISPLAY_TYPE == DISPLAY_GRAPHIC
+static Oled_InitTypeDef Oled_InitStruct;
+#else
+static SegLcd_InitTypeDef SegLcd_InitStruct;
+#endif
 static Key_InitTypeDef Key_InitStruct;
+static Batch_InitTypeDef Batch_InitStruct;
+static OverloadTrip_InitTypeDef OverloadTrip_InitStruct;
+static SchedTask_InitTypeDef SchedTask_InitStruct;
+static Power_InitTypeDef Power_InitStruct;
+static Clock_InitTypeDef Clock_InitStruct;
+static DebugUart_InitTypeDef DebugUart_InitStruct;
+static Supervisor_InitTypeDef Supervisor_InitStruct;
 
 /**
   * @brief  Ӧòʼ
   */
 void Application_Init(void)
 {
+	/* ʱӵλʼ浵λϵ64MHzʱ٣ */
+    Clock_InitStruct.RunProfile = CLOCK_PROFILE_NORMAL;
+    ClockManager_Init(&Clock_InitStruct);
+    
+    /* ж¼гʼģʼʱ¼ʱҲУ */
+    EventQueue_Init();
+    
 	/* ϵͳʱʼ*/
     SystemTimer_Init();
     
+    /* ԴڣUART0115200͵ַ */
+    DebugUart_InitStruct.UARTx = UART0;
+    DebugUart_InitStruct.BaudRate = 115200;
+    DebugUart_Init(&DebugUart_InitStruct);
+    ClockManager_RegisterCallback(DebugUart_ClockChanged);
+    DebugConsole_Init();
+    Profiler_Init();
+    MemMonitor_Init();
+    
+    /* Ź໤500msʱģʼʱǼϴεļ໤λ */
+    Supervisor_InitStruct.Timeout = WDT_OverTime_500MS;
+    Supervisor_Init(&Supervisor_InitStruct);
+    
     /* ʼ */
     WeightSensor_InitStruct.OPx = OP;
     WeightSensor_InitStruct.ADCx = ADC;
@@ -30,11 +74,47 @@ void Application_Init(void)
     Buzzer_InitStruct.Frequency = 4000;
     Buzzer_InitStruct.DutyCycle = 50;
     Buzzer_Init(&Buzzer_InitStruct);
+    ClockManager_RegisterCallback(Buzzer_ClockChanged);
+    
+#if DISPLAY_TYPE == DISPLAY_LED_SEG
+    /* LEDܳʼӲɨ裬LEDPWMڶȣ */
+    LedSeg_InitStruct.FrameFre = LED_FrameFre_B128Hz;
+    LedSeg_InitStruct.PwmChannel = 0x000000FFU;    // SEG0-7
+    LedSeg_InitStruct.PwmPrescaler = LEDPWM_PRESCALER_DIV16;
+    LedSeg_InitStruct.Brightness = LED_BRIGHTNESS_ACTIVE;
+    LedSeg_Init(&LedSeg_InitStruct);
+#elif DISPLAY_TYPE == DISPLAY_GRAPHIC
+    /* ͼOLEDʼSPI0+DMA0ͣPB4/PB5λ */
+    Oled_InitStruct.SPIx = SPI0;
+    Oled_InitStruct.Prescaler = SPI_Prescaler_8;
+    Oled_InitStruct.DMAx = DMA0;
+    Oled_InitStruct.DMA_Request = DMA_Request_SPI0_TX;
+    Oled_InitStruct.CtrlGPIOx = GPIOB;
+    Oled_InitStruct.DcPin = GPIO_Pin_4;
+    Oled_InitStruct.RstPin = GPIO_Pin_5;
+    Oled_Init(&Oled_InitStruct);
+#else
+    /* Һʼ1/4ռձȣ1/3ƫѹ */
+    SegLcd_InitStruct.FrameFre = LCD_FrameFre_B64Hz;
+    SegLcd_InitStruct.Bias = LCD_Bias_1_3;
+    SegLcd_InitStruct.Voltage = 8;
+    SegLcd_Init(&SegLcd_InitStruct);
+#endif
+    
+    /* ӲرȽʼ˷ֱӽӱȽ */
+    OverloadTrip_InitStruct.CMPx = CMP;
+    OverloadTrip_InitStruct.SupplyVoltage = 3.3f;
+    OverloadTrip_Init(&OverloadTrip_InitStruct);
+    OverloadProtection_Update();
     
     /* 4ʼ */
     Key_InitStruct.GPIOx = GPIOA;
     Key_InitStruct.INT_Port = INT_INTSEL_PA;
     Key_InitStruct.ActiveLevel = KEY_PRESSED;
+    Key_InitStruct.DebounceMs = 20;
+    Key_InitStruct.LongPressMs = 0;
+    Key_InitStruct.RepeatMs = 0;
+    Key_InitStruct.DoubleClickMs = 0;
     
     // 1: ȥƤ
     Key_InitStruct.GPIO_Pin = GPIO_Pin_0;
@@ -60,8 +140,77 @@ void Application_Init(void)
     Key_InitStruct.KeyID = KEY_ID_POWER;
     Key_Init(&Key_InitStruct);
     
-    /* ûص */
-    Key_SetPressCallback(Key_Pressed_Handler);
+    // ϼ: ȥƤ+У׼ У׼
+    Key_AddChord(KEY_MASK(KEY_ID_TARE) | KEY_MASK(KEY_ID_CALIB));
+    // ϼ: ȥƤ+ ʼװ
+    Key_AddChord(KEY_MASK(KEY_ID_TARE) | KEY_MASK(KEY_ID_MEASURE));
+    
+    /* װƳʼPB0ϷPB1Ϸ */
+    Batch_InitStruct.FastGPIOx = GPIOB;
+    Batch_InitStruct.FastPin = GPIO_Pin_0;
+    Batch_InitStruct.SlowGPIOx = GPIOB;
+    Batch_InitStruct.SlowPin = GPIO_Pin_1;
+    Batch_InitStruct.SlowFeedBand = 50.0f;
+    Batch_InitStruct.InitialPreact = 5.0f;
+    Batch_InitStruct.MaxPreact = 100.0f;
+    Batch_InitStruct.LearnGainPercent = 50;
+    Batch_InitStruct.SettleTimeMs = BATCH_DEFAULT_SETTLE_MS;
+    BatchController_Init(&Batch_InitStruct);
+    
+    /* ͹ĹʼʱSTOPBTMÿ뻽ѣǰЧĿ5ms */
+    Power_InitStruct.Profile = POWER_PROFILE_CONTINUOUS;
+    Power_InitStruct.WakeInterval = BTM_FreqSelect_1S;
+    Power_InitStruct.WakeIntervalMs = 1000;
+    Power_InitStruct.WakeTargetUs = 5000;
+    PowerManager_Init(&Power_InitStruct);
+    
+    /* ûصжֻͶ¼ҵѭд */
+    Key_SetEventCallback(Key_EventISR);
+    EventQueue_Subscribe(EVENT_KEY, Key_EventHandler);
+    
+    /* ӳ״̬ʼ */
+    Scale_Init();
+    
+    /* ȱʱռSysTickжϷֵʱͶ¼ */
+    // 1: װ̨䶨ʱ
+    SchedTask_InitStruct.Function = BatchController_Process;
+    SchedTask_InitStruct.PeriodMs = 10;
+    SchedTask_InitStruct.PhaseMs = 0;
+    SchedTask_InitStruct.Priority = 1;
+    SchedTask_InitStruct.BudgetUs = 500;
+    Scheduler_AddTask(&SchedTask_InitStruct);
+    
+    // 2: ӳ״̬ʾغͻ⣩
+    SchedTask_InitStruct.Function = Scale_Tick;
+    SchedTask_InitStruct.PeriodMs = POWER_CONTINUOUS_READ_MS;     // ÿһ뻬
+    SchedTask_InitStruct.PhaseMs = 5;
+    SchedTask_InitStruct.Priority = 2;
+    SchedTask_InitStruct.BudgetUs = 5000;
+    Scheduler_AddTask(&SchedTask_InitStruct);
+    
+#if DISPLAY_TYPE == DISPLAY_GRAPHIC
+    // ͼʾˢ£һηһDMAֻͣôڣ
+    SchedTask_InitStruct.Function = Oled_Flush;
+    SchedTask_InitStruct.PeriodMs = 5;
+    SchedTask_InitStruct.PhaseMs = 0;
+    SchedTask_InitStruct.Priority = 2;
+    SchedTask_InitStruct.BudgetUs = 300;
+    Scheduler_AddTask(&SchedTask_InitStruct);
+#endif
+    
+    // 3: Ź໤ȼȫʱ򿨲ι
+    SchedTask_InitStruct.Function = Supervisor_Process;
+    SchedTask_InitStruct.PeriodMs = 50;
+    SchedTask_InitStruct.PhaseMs = 0;
+    SchedTask_InitStruct.Priority = 3;
+    SchedTask_InitStruct.BudgetUs = 100;
+    Scheduler_AddTask(&SchedTask_InitStruct);
+    
+    /* ޵޴¼ʱߣIDLESTOP */
+    Scheduler_SetPendingCheck(EventQueue_IsPending);
+    Scheduler_SetIdleHook(PowerManager_IdleHook);
+    Scheduler_Start();
+    Supervisor_Start();
     
     /* ʼʾ */
     Buzzer_Beep(100);
@@ -8,6 +8,10 @@
 #include "system_timer.h"
 #include "key.h"
 #include "buzzer.h"
+#include "seg_lcd.h"
+#include "led_seg.h"
+#include "oled.h"
+#include "overload_trip.h"
 
 /* Ӧòʼ */
 void Application_Init(void);
@@ -0,0 +1,309 @@
+//batch_controller.c
+
+#include "batch_controller.h"
+#include "weight_sensor.h"
+#include "system_timer.h"
+#include "event_queue.h"
+#include "clock_manager.h"
+#include "ram_code.h"
+#include "supervisor.h"
+
+#define BATCH_FILTER_LEN    (1U << BATCH_FILTER_SHIFT)
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static Batch_InitTypeDef Batch_Config;
+static Batch_ResultTypeDef Batch_Result = {0};
+
+static volatile BatchState Batch_State = BATCH_IDLE;
+static float Batch_Target = 0.0f;                 // ǰĿ
+static float Batch_Preact = 0.0f;                 // ѧϰõǰ
+static Time_Ms Batch_CutoffTime;                  // ֹʱ
+static uint8_t Batch_Boosted = 0;                 // װڼ
+static int8_t Batch_Heartbeat = -1;               // Ź໤
+
+/* ·ʹõޣж */
+static uint32_t Batch_SlowCount = 0;              // رտϵļֵ
+static uint32_t Batch_CutoffCount = 0;            // رϵļֵ
+
+/* ·̴˲ */
+static uint16_t Batch_FilterBuffer[BATCH_FILTER_LEN];
+static uint32_t Batch_FilterSum = 0;
+static uint8_t Batch_FilterIndex = 0;
+static uint8_t Batch_FilterPrimed = 0;
+
+/* ɼ */
+static volatile uint32_t Batch_MeasureSum = 0;
+static volatile uint16_t Batch_MeasureCount = 0;
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  رȫϷ
+  */
+static void Batch_CloseValves(void)
+{
+    GPIO_ResetBits(Batch_Config.FastGPIOx, Batch_Config.FastPin);
+    GPIO_ResetBits(Batch_Config.SlowGPIOx, Batch_Config.SlowPin);
+}
+
+/**
+  * @brief  ͷŹװڼ
+  */
+static void Batch_ReleaseBoost(void)
+{
+    if(Batch_Boosted) {
+        Batch_Boosted = 0;
+        ClockManager_ReleaseBoost();
+    }
+}
+
+/**
+  * @brief  ·ADCжеãִʱ̶
+  * @param  rawSample: ԭʼADCֵ
+  */
+static RAM_FUNC void Batch_SampleHandler(uint16_t rawSample)
+{
+    uint32_t level;
+
+    /* ׸ڣʱĽԾ */
+    if(!Batch_FilterPrimed) {
+        for(uint8_t i = 0; i < BATCH_FILTER_LEN; i++) {
+            Batch_FilterBuffer[i] = rawSample;
+        }
+        Batch_FilterSum = (uint32_t)rawSample << BATCH_FILTER_SHIFT;
+        Batch_FilterPrimed = 1;
+    }
+
+    /* ̴ڻƽ */
+    Batch_FilterSum -= Batch_FilterBuffer[Batch_FilterIndex];
+    Batch_FilterSum += rawSample;
+    Batch_FilterBuffer[Batch_FilterIndex] = rawSample;
+    Batch_FilterIndex = (Batch_FilterIndex + 1) & (BATCH_FILTER_LEN - 1);
+    level = Batch_FilterSum >> BATCH_FILTER_SHIFT;
+
+    switch(Batch_State) {
+        case BATCH_FAST_FEED:
+        case BATCH_SLOW_FEED:
+            if(level >= Batch_CutoffCount) {
+                // ֹ㣺رȫ
+                Batch_CloseValves();
+                Batch_CutoffTime = Time_NowMs();
+                Batch_State = BATCH_SETTLING;
+            } else if(Batch_State == BATCH_FAST_FEED && level >= Batch_SlowCount) {
+                // 䣺رտϷ
+                GPIO_ResetBits(Batch_Config.FastGPIOx, Batch_Config.FastPin);
+                Batch_State = BATCH_SLOW_FEED;
+            }
+            break;
+        case BATCH_MEASURING:
+            if(Batch_MeasureCount < BATCH_MEASURE_SAMPLES) {
+                Batch_MeasureSum += rawSample;
+                Batch_MeasureCount++;
+                if(Batch_MeasureCount == BATCH_MEASURE_SAMPLES) {
+                    // ɼɣǰѧϰѭʱBatchController_Process
+                    EventQueue_Post(EVENT_BATCH_MEASURED, 0, 0);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+  * @brief  ɼɣѭģѧϰǰ
+  */
+static void Batch_FinishMeasure(void)
+{
+    if(Batch_State != BATCH_MEASURING || Batch_MeasureCount < BATCH_MEASURE_SAMPLES) return;
+
+    WeightSensor_StopContinuous();
+    WeightSensor_SetSampleCallback(0);
+
+    Batch_Result.FinalWeight = WeightSensor_CountToGram(Batch_MeasureSum / BATCH_MEASURE_SAMPLES);
+    Batch_Result.Overshoot = Batch_Result.FinalWeight - Batch_Target;
+
+    /* ǰѧϰεĹ/ */
+    Batch_Preact += Batch_Result.Overshoot * Batch_Config.LearnGainPercent / 100.0f;
+    if(Batch_Preact < 0.0f) {
+        Batch_Preact = 0.0f;
+    } else if(Batch_Preact > Batch_Config.MaxPreact) {
+        Batch_Preact = Batch_Config.MaxPreact;
+    }
+
+    Batch_State = BATCH_DONE;
+    Batch_ReleaseBoost();
+    Supervisor_HeartbeatCmd(Batch_Heartbeat, DISABLE);
+}
+
+/**
+  * @brief  ɼ¼
+  */
+static void Batch_MeasuredHandler(const Event_t* event)
+{
+    (void)event;
+    Batch_FinishMeasure();
+}
+
+/**
+  * @brief  װƳʼ
+  */
+void BatchController_Init(Batch_InitTypeDef* Batch_InitStruct)
+{
+    /*  */
+    Batch_Config = *Batch_InitStruct;
+    if(Batch_Config.SettleTimeMs == 0) {
+        Batch_Config.SettleTimeMs = BATCH_DEFAULT_SETTLE_MS;
+    }
+    if(Batch_Config.LearnGainPercent > 100) {
+        Batch_Config.LearnGainPercent = 100;
+    }
+    Batch_Preact = Batch_Config.InitialPreact;
+
+    /*  - ʼر */
+    GPIO_InitTypeDef GPIO_InitStructure;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT_PP;
+    GPIO_InitStructure.GPIO_DriveLevel = GPIO_DriveLevel_0;
+
+    GPIO_InitStructure.GPIO_Pin = Batch_Config.FastPin;
+    GPIO_Init(Batch_Config.FastGPIOx, &GPIO_InitStructure);
+
+    GPIO_InitStructure.GPIO_Pin = Batch_Config.SlowPin;
+    GPIO_Init(Batch_Config.SlowGPIOx, &GPIO_InitStructure);
+
+    Batch_CloseValves();
+    Batch_State = BATCH_IDLE;
+
+    EventQueue_Subscribe(EVENT_BATCH_MEASURED, Batch_MeasuredHandler);
+    /* ֻڹװڼ */
+    Batch_Heartbeat = Supervisor_Register("batch", 100);
+    Supervisor_HeartbeatCmd(Batch_Heartbeat, DISABLE);
+}
+
+/**
+  * @brief  һιװ
+  * @param  targetWeight: Ŀ꾻(g)
+  * @retval 1:   0: ڹװĿЧ
+  */
+uint8_t BatchController_Start(float targetWeight)
+{
+    float cutoffWeight;
+
+    if(Batch_State != BATCH_IDLE && Batch_State != BATCH_DONE && Batch_State != BATCH_ABORTED) {
+        return 0;
+    }
+    if(targetWeight <= 0.0f) return 0;
+
+    Batch_Target = targetWeight;
+
+    /* ֹ㣺ĿȥǰڽֹǰSlowFeedBandر */
+    cutoffWeight = targetWeight - Batch_Preact;
+    Batch_CutoffCount = WeightSensor_GramToCount(cutoffWeight);
+    Batch_SlowCount = WeightSensor_GramToCount(cutoffWeight - Batch_Config.SlowFeedBand);
+
+    Batch_FilterPrimed = 0;
+    Batch_FilterIndex = 0;
+    Batch_MeasureSum = 0;
+    Batch_MeasureCount = 0;
+
+    Batch_Result.TargetWeight = targetWeight;
+    Batch_Result.Preact = Batch_Preact;
+
+    /* ̬ڼ٣֤жϵĴ */
+    if(!Batch_Boosted) {
+        Batch_Boosted = 1;
+        ClockManager_RequestBoost();
+    }
+    
+    /* 򿪷ţлжϲ */
+    Batch_State = BATCH_FAST_FEED;
+    GPIO_SetBits(Batch_Config.FastGPIOx, Batch_Config.FastPin);
+    GPIO_SetBits(Batch_Config.SlowGPIOx, Batch_Config.SlowPin);
+
+    WeightSensor_SetSampleCallback(Batch_SampleHandler);
+    WeightSensor_StartContinuous();
+    Supervisor_HeartbeatCmd(Batch_Heartbeat, ENABLE);
+    return 1;
+}
+
+/**
+  * @brief  ֹװرշţ
+  */
+void BatchController_Abort(void)
+{
+    if(Batch_State == BATCH_IDLE || Batch_State == BATCH_DONE || Batch_State == BATCH_ABORTED) {
+        return;
+    }
+
+    Batch_CloseValves();
+    WeightSensor_StopContinuous();
+    WeightSensor_SetSampleCallback(0);
+    Batch_State = BATCH_ABORTED;
+    Batch_ReleaseBoost();
+    Supervisor_HeartbeatCmd(Batch_Heartbeat, DISABLE);
+}
+
+/**
+  * @brief  װ̨ѭã䶨ȴɼ¼ʧʱ
+  */
+void BatchController_Process(void)
+{
+    Supervisor_CheckIn(Batch_Heartbeat);
+    switch(Batch_State) {
+        case BATCH_SETTLING:
+            if(Time_ElapsedMs(Batch_CutoffTime) >= Batch_Config.SettleTimeMs) {
+                Batch_MeasureSum = 0;
+                Batch_MeasureCount = 0;
+                Batch_State = BATCH_MEASURING;
+            }
+            break;
+
+        case BATCH_MEASURING:
+            /* жͶEVENT_BATCH_MEASUREDʱп */
+            if(Batch_MeasureCount == BATCH_MEASURE_SAMPLES) {
+                Batch_FinishMeasure();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+  * @brief  ȡװ״̬
+  */
+BatchState BatchController_GetState(void)
+{
+    return Batch_State;
+}
+
+/**
+  * @brief  ȡǰǰ(g)
+  */
+float BatchController_GetPreact(void)
+{
+    return Batch_Preact;
+}
+
+/**
+  * @brief  ǰ(g)ӱĲָ
+  */
+void BatchController_SetPreact(float preact)
+{
+    if(preact < 0.0f) preact = 0.0f;
+    if(preact > Batch_Config.MaxPreact) preact = Batch_Config.MaxPreact;
+    Batch_Preact = preact;
+}
+
+/**
+  * @brief  ȡһιװ
+  */
+const Batch_ResultTypeDef* BatchController_GetLastResult(void)
+{
+    return &Batch_Result;
+}
@@ -0,0 +1,63 @@
+//batch_controller.h
+
+#ifndef __BATCH_CONTROLLER_H
+#define __BATCH_CONTROLLER_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_gpio.h"
+
+/** @defgroup װض
+  * @{
+  */
+#define BATCH_FILTER_SHIFT        2       // ·˲ 2^2 = 4
+#define BATCH_MEASURE_SAMPLES     64      // ȶڼĲ
+#define BATCH_DEFAULT_SETTLE_MS   800     // ֹȴ䶨ʱ
+
+/** @}
+  */
+
+/* װ״̬ */
+typedef enum {
+    BATCH_IDLE = 0,       // 
+    BATCH_FAST_FEED,      // ϣ졢򿪣
+    BATCH_SLOW_FEED,      // ϣ򿪣
+    BATCH_SETTLING,       // ѽֹȴ䶨
+    BATCH_MEASURING,      // ɼ
+    BATCH_DONE,           // ιװ
+    BATCH_ABORTED         // ֹ
+} BatchState;
+
+/** @brief װýṹ */
+typedef struct {
+    GPIO_TypeDef* FastGPIOx;     // Ϸ˿
+    uint16_t FastPin;            // Ϸ
+    GPIO_TypeDef* SlowGPIOx;     // Ϸ˿
+    uint16_t SlowPin;            // Ϸ
+    float SlowFeedBand;          // (g)Ŀٿ˹رտ
+    float InitialPreact;         // ʼǰ(g)
+    float MaxPreact;             // ǰ(g)
+    uint8_t LearnGainPercent;    // ǰѧϰ棨0-100%
+    uint32_t SettleTimeMs;       // ֹȶȴʱ(ms)
+} Batch_InitTypeDef;
+
+/** @brief һιװ */
+typedef struct {
+    float TargetWeight;          // Ŀ(g)
+    float FinalWeight;           // (g)
+    float Overshoot;             // Ŀ(g)ֵʾ
+    float Preact;                // ʹõǰ(g)
+} Batch_ResultTypeDef;
+
+/* ʼͿƺ */
+void BatchController_Init(Batch_InitTypeDef* Batch_InitStruct);
+uint8_t BatchController_Start(float targetWeight);
+void BatchController_Abort(void);
+void BatchController_Process(void);
+
+/* ״̬ѯ */
+BatchState BatchController_GetState(void);
+float BatchController_GetPreact(void);
+void BatchController_SetPreact(float preact);
+const Batch_ResultTypeDef* BatchController_GetLastResult(void);
+
+#endif /* __BATCH_CONTROLLER_H */
@@ -0,0 +1,243 @@
+//clock_manager.c
+
+#include "clock_manager.h"
+#include "system_timer.h"
+
+#define CLOCK_PLL_LOCK_LOOPS    100000  // ȴPLLѯ
+
+/** @brief ʱӵλ */
+typedef struct {
+    RCC_SYSCLKSource_TypeDef Source;    // ϵͳʱԴ
+    RCC_HCLK_TypeDef HCLKDiv;           // AHBƵ
+} Clock_ProfileTypeDef;
+
+/** @defgroup ģ˽б
+  * @{
+  */
+#if defined(SC32f10xx)
+static const Clock_ProfileTypeDef Clock_Profiles[CLOCK_PROFILE_MAX] = {
+    { RCC_SYSCLKSource_HIRC,    RCC_SYSCLK_Div8 },   // 
+    { RCC_SYSCLKSource_HIRC,    RCC_SYSCLK_Div1 },   // 
+    { RCC_SYSCLKSource_PLLRCLK, RCC_SYSCLK_Div1 },   // PLL
+};
+#else
+/*
+ * SC32f12xxûPLLHIRC 64MHzΪƵλֻAHBƵ
+ * 浵λϵʱ64MHzADCSPIƵͶ/LEDɨ谴HCLKã
+ * ûеǼʱӱ仯صƵıǵʱٵλ볣浵λͬ
+ */
+static const Clock_ProfileTypeDef Clock_Profiles[CLOCK_PROFILE_MAX] = {
+    { RCC_SYSCLKSource_HIRC,    RCC_SYSCLK_Div8 },   // 8MHz
+    { RCC_SYSCLKSource_HIRC,    RCC_SYSCLK_Div1 },   // 64MHz
+    { RCC_SYSCLKSource_HIRC,    RCC_SYSCLK_Div1 },   // 64MHz
+};
+#endif
+
+static Clock_Profile RunProfile = CLOCK_PROFILE_NORMAL;
+static Clock_Profile CurrentProfile = CLOCK_PROFILE_MAX;   // ϵʱSC_RCC_InitãΪδ֪
+static uint8_t BoostRequests = 0;                 // 
+static uint8_t LowSpeed = 0;                      // 
+static uint32_t SwitchCount = 0;
+
+static Clock_ChangeCallback Callbacks[CLOCK_MAX_CALLBACKS];
+static uint8_t CallbackCount = 0;
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  HCLKѡȡFlashȴ
+  */
+static RCC_Wait_TypeDef Clock_WaitFor(uint32_t hclk)
+{
+    if(hclk <= CLOCK_WAIT0_MAX_HZ) return RCC_WAIT_0;
+    if(hclk <= CLOCK_WAIT1_MAX_HZ) return RCC_WAIT_1;
+    if(hclk <= CLOCK_WAIT2_MAX_HZ) return RCC_WAIT_2;
+    return RCC_WAIT_3;
+}
+
+#if defined(SC32f10xx)
+/**
+  * @brief  òPLL
+  * @retval 1:   0: ʱ
+  */
+static uint8_t Clock_StartPLL(void)
+{
+    RLL_Factor_TypeDef factor;
+    uint32_t loops = CLOCK_PLL_LOCK_LOOPS;
+
+    factor.PLLM = CLOCK_PLL_M;
+    factor.PLLN = CLOCK_PLL_N;
+    factor.PLLP = CLOCK_PLL_P;
+    RCC_PLLConfig(RCC_PLLCLKSource_HIRC, &factor);
+    RCC_PLLCmd(ENABLE);
+
+    while(RCC_GetFlagStatus(RCC_FLAG_PLLRDY) == RESET) {
+        if(--loops == 0) {
+            RCC_PLLCmd(DISABLE);
+            return 0;
+        }
+    }
+    RCC_PLLRCmd(ENABLE);
+    return 1;
+}
+#endif
+
+/**
+  * @brief  лָλ֪ͨ¼ʱ
+  * @retval 1: л  0: лʧܣԭλ
+  */
+static uint8_t Clock_Apply(Clock_Profile profile)
+{
+    const Clock_ProfileTypeDef* target = &Clock_Profiles[profile];
+    RCC_ClocksTypeDef clocks;
+    uint32_t primask;
+
+    if(profile == CurrentProfile) return 1;
+
+    /* ͬĵλSC32f12xxĳ/٣ãҲ֪ͨ */
+    if(CurrentProfile != CLOCK_PROFILE_MAX &&
+       Clock_Profiles[CurrentProfile].Source == target->Source &&
+       Clock_Profiles[CurrentProfile].HCLKDiv == target->HCLKDiv) {
+        CurrentProfile = profile;
+        return 1;
+    }
+
+#if defined(SC32f10xx)
+    if(target->Source == RCC_SYSCLKSource_PLLRCLK && !Clock_StartPLL()) {
+        return 0;
+    }
+#endif
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    /* ȰȴڣлɺٰHCLK */
+    RCC_WaitConfig(RCC_WAIT_3);
+    if(CurrentProfile == CLOCK_PROFILE_MAX || Clock_Profiles[CurrentProfile].Source != target->Source) {
+        if(RCC_SYSCLKConfig(target->Source) != SUCCESS) {
+            RCC_GetClocksFreq(&clocks);
+            RCC_WaitConfig(Clock_WaitFor(clocks.HCLK_Frequency));
+            __set_PRIMASK(primask);
+            return 0;
+        }
+    }
+    RCC_HCLKConfig(target->HCLKDiv);
+
+    RCC_GetClocksFreq(&clocks);
+    RCC_WaitConfig(Clock_WaitFor(clocks.HCLK_Frequency));
+
+    /* ʱ׼ڿжǰָ1ms */
+    SystemTimer_ConfigSysTick();
+    __set_PRIMASK(primask);
+
+#if defined(SC32f10xx)
+    if(target->Source != RCC_SYSCLKSource_PLLRCLK) {
+        RCC_PLLRCmd(DISABLE);
+        RCC_PLLCmd(DISABLE);
+    }
+#endif
+
+    CurrentProfile = profile;
+    SwitchCount++;
+
+    for(uint8_t i = 0; i < CallbackCount; i++) {
+        Callbacks[i](&clocks);
+    }
+    return 1;
+}
+
+/**
+  * @brief  ǰѡȡλȣ󣬷򳣹浵λ
+  */
+static void Clock_Update(void)
+{
+    if(LowSpeed) {
+        Clock_Apply(CLOCK_PROFILE_LOW);
+    } else if(BoostRequests > 0) {
+        Clock_Apply(CLOCK_PROFILE_BOOST);
+    } else {
+        Clock_Apply(RunProfile);
+    }
+}
+
+/**
+  * @brief  ʱӹʼӦʼ֮ǰã
+  */
+void ClockManager_Init(Clock_InitTypeDef* Clock_InitStruct)
+{
+    RunProfile = Clock_InitStruct->RunProfile;
+    if(RunProfile >= CLOCK_PROFILE_MAX) {
+        RunProfile = CLOCK_PROFILE_NORMAL;
+    }
+
+    CallbackCount = 0;
+    BoostRequests = 0;
+    LowSpeed = 0;
+    CurrentProfile = CLOCK_PROFILE_MAX;
+    Clock_Update();
+}
+
+/**
+  * @brief  עʱӱ仯صʼʱעᣬлƵ¼㣩
+  * @retval 1: ע  0: ص
+  */
+uint8_t ClockManager_RegisterCallback(Clock_ChangeCallback callback)
+{
+    if(callback == 0 || CallbackCount >= CLOCK_MAX_CALLBACKS) return 0;
+
+    Callbacks[CallbackCount++] = callback;
+    return 1;
+}
+
+/**
+  * @brief  ٣ClockManager_ReleaseBoostɶԵã
+  */
+void ClockManager_RequestBoost(void)
+{
+    if(BoostRequests < 0xFF) BoostRequests++;
+    Clock_Update();
+}
+
+/**
+  * @brief  ͷȫͷźص浵λ
+  */
+void ClockManager_ReleaseBoost(void)
+{
+    if(BoostRequests > 0) BoostRequests--;
+    Clock_Update();
+}
+
+/**
+  * @brief  /˳ٵλ
+  */
+void ClockManager_SetLowSpeed(uint8_t enable)
+{
+    LowSpeed = (enable != 0);
+    Clock_Update();
+}
+
+/**
+  * @brief  ȡǰʱӵλ
+  */
+Clock_Profile ClockManager_GetProfile(void)
+{
+    return CurrentProfile;
+}
+
+/**
+  * @brief  ȡǰƵ
+  */
+void ClockManager_GetClocks(RCC_ClocksTypeDef* clocks)
+{
+    RCC_GetClocksFreq(clocks);
+}
+
+/**
+  * @brief  ȡλл
+  */
+uint32_t ClockManager_GetSwitchCount(void)
+{
+    return SwitchCount;
+}
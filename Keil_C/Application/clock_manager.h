@@ -0,0 +1,57 @@
+//clock_manager.h
+
+#ifndef __CLOCK_MANAGER_H
+#define __CLOCK_MANAGER_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_rcc.h"
+
+/** @defgroup ʱӵλض
+  * @{
+  */
+#define CLOCK_MAX_CALLBACKS      4       // ʱӱ仯ص
+
+/* FlashȴHCLK޶ӦϵоƬֲȷϣ */
+#define CLOCK_WAIT0_MAX_HZ       16000000
+#define CLOCK_WAIT1_MAX_HZ       32000000
+#define CLOCK_WAIT2_MAX_HZ       64000000
+
+#if defined(SC32f10xx)
+/* PLL = (HIRC / M) * N / 2^(P+1)оƬֲ᷶Χѡȡ */
+#define CLOCK_PLL_M              32
+#define CLOCK_PLL_N              96
+#define CLOCK_PLL_P              0
+#endif
+
+/** @}
+  */
+
+/* ʱӵλ */
+typedef enum {
+    CLOCK_PROFILE_LOW = 0,      // ٣HCLKƵͿʱʹ
+    CLOCK_PROFILE_NORMAL,       // 
+    CLOCK_PROFILE_BOOST,        // ٣˲̬أװ
+    CLOCK_PROFILE_MAX
+} Clock_Profile;
+
+/** @brief ʱӱ仯صлɺѭеã¼Ƶ//ʣ */
+typedef void (*Clock_ChangeCallback)(const RCC_ClocksTypeDef* clocks);
+
+/** @brief ʱӹýṹ */
+typedef struct {
+    Clock_Profile RunProfile;   // еλδʱʹã
+} Clock_InitTypeDef;
+
+/* ʼͿƺ */
+void ClockManager_Init(Clock_InitTypeDef* Clock_InitStruct);
+uint8_t ClockManager_RegisterCallback(Clock_ChangeCallback callback);
+void ClockManager_RequestBoost(void);
+void ClockManager_ReleaseBoost(void);
+void ClockManager_SetLowSpeed(uint8_t enable);
+
+/* ״̬ѯ */
+Clock_Profile ClockManager_GetProfile(void);
+void ClockManager_GetClocks(RCC_ClocksTypeDef* clocks);
+uint32_t ClockManager_GetSwitchCount(void);
+
+#endif /* __CLOCK_MANAGER_H */
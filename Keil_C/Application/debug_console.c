@@ -0,0 +1,99 @@
+//debug_console.c
+
+#include "debug_console.h"
+#include "debug_uart.h"
+#include "event_queue.h"
+
+/** @brief ַ */
+typedef struct {
+    char Key;
+    DebugConsole_Handler Handler;
+    const char* Help;
+} DebugConsole_Command;
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static DebugConsole_Command Commands[DEBUG_CONSOLE_MAX_COMMANDS];
+static uint8_t CommandCount = 0;
+static uint32_t CommandArg = 0;          // ַǰʮƲ
+static uint8_t CommandArgValid = 0;
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  ӡб
+  */
+static void DebugConsole_PrintHelp(void)
+{
+    for(uint8_t i = 0; i < CommandCount; i++) {
+        DebugUart_WriteChar(Commands[i].Key);
+        DebugUart_WriteString("  ");
+        DebugUart_WriteString(Commands[i].Help);
+        DebugUart_WriteNewLine();
+    }
+}
+
+/**
+  * @brief  ڽ¼ѭģۼΪַҲִ
+  * @note   "250b"Բ250ִbִк
+  */
+static void DebugConsole_RxHandler(const Event_t* event)
+{
+    char key = (char)event->param;
+
+    if(key >= '0' && key <= '9') {
+        if(CommandArg < 100000000U) {
+            CommandArg = CommandArg * 10 + (uint32_t)(key - '0');
+        }
+        CommandArgValid = 1;
+        return;
+    }
+
+    for(uint8_t i = 0; i < CommandCount; i++) {
+        if(Commands[i].Key == key) {
+            Commands[i].Handler();
+            break;
+        }
+    }
+    CommandArg = 0;
+    CommandArgValid = 0;
+}
+
+/**
+  * @brief  ʼԴں¼гʼ֮ã
+  */
+void DebugConsole_Init(void)
+{
+    CommandCount = 0;
+    DebugConsole_AddCommand('?', DebugConsole_PrintHelp, "help");
+    EventQueue_Subscribe(EVENT_UART_RX, DebugConsole_RxHandler);
+}
+
+/**
+  * @brief  עᵥַ
+  * @retval 1: ע  0: 
+  */
+uint8_t DebugConsole_AddCommand(char key, DebugConsole_Handler handler, const char* help)
+{
+    if(handler == 0 || CommandCount >= DEBUG_CONSOLE_MAX_COMMANDS) return 0;
+
+    Commands[CommandCount].Key = key;
+    Commands[CommandCount].Handler = handler;
+    Commands[CommandCount].Help = help;
+    CommandCount++;
+    return 1;
+}
+
+/**
+  * @brief  ȡǰֲеã
+  * @param  value: ֵ
+  * @retval 1: ǰ˲  0: ޲
+  */
+uint8_t DebugConsole_GetArg(uint32_t* value)
+{
+    *value = CommandArg;
+    return CommandArgValid;
+}
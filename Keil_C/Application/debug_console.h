@@ -0,0 +1,24 @@
+//debug_console.h
+
+#ifndef __DEBUG_CONSOLE_H
+#define __DEBUG_CONSOLE_H
+
+#include "sc32f1xxx.h"
+
+/** @defgroup ض
+  * @{
+  */
+#define DEBUG_CONSOLE_MAX_COMMANDS   8       // ַ
+
+/** @}
+  */
+
+/** @brief ѭеãַǰɴʮƲ */
+typedef void (*DebugConsole_Handler)(void);
+
+/* ʼעắ */
+void DebugConsole_Init(void);
+uint8_t DebugConsole_AddCommand(char key, DebugConsole_Handler handler, const char* help);
+uint8_t DebugConsole_GetArg(uint32_t* value);
+
+#endif /* __DEBUG_CONSOLE_H */
@@ -0,0 +1,133 @@
+//event_queue.c
+
+#include "event_queue.h"
+#include "ram_code.h"
+#include "mem_monitor.h"
+
+#define EVENT_QUEUE_MASK    (EVENT_QUEUE_SIZE - 1)
+
+/*
+ * /ζУ
+ * ΪжϣжʹͬһȼụǶף൱һߣ
+ * ֻдHeadΪѭֻдTailԵҪжϡ
+ */
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static Event_t EventBuffer[EVENT_QUEUE_SIZE];
+static volatile uint8_t EventHead = 0;               // джϣ
+static volatile uint8_t EventTail = 0;               // ѭ
+static Event_Handler EventHandlers[EVENT_TYPE_MAX];   // ͶĵĴ
+static volatile uint32_t OverflowCount = 0;          // 
+static uint8_t HighWater = 0;                        // ѹ
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  ¼гʼ
+  */
+void EventQueue_Init(void)
+{
+    EventHead = 0;
+    EventTail = 0;
+    OverflowCount = 0;
+    HighWater = 0;
+    for(uint8_t i = 0; i < EVENT_TYPE_MAX; i++) {
+        EventHandlers[i] = 0;
+    }
+    MemMonitor_AddModule("event_queue", sizeof(EventBuffer) + sizeof(EventHandlers));
+}
+
+/**
+  * @brief  ¼ͣʼ׶εãÿһ
+  */
+void EventQueue_Subscribe(EventType type, Event_Handler handler)
+{
+    if(type >= EVENT_TYPE_MAX) return;
+    EventHandlers[type] = handler;
+}
+
+/**
+  * @brief  Ͷ¼жеãִʱ̶
+  * @retval 1: ɹ  0: ¼
+  */
+RAM_FUNC uint8_t EventQueue_Post(EventType type, uint8_t param, uint16_t data)
+{
+    uint8_t head = EventHead;
+    uint8_t used = (uint8_t)(head - EventTail);
+    Event_t* slot;
+
+    if(used >= EVENT_QUEUE_SIZE) {
+        OverflowCount++;
+        return 0;
+    }
+    if(used + 1 > HighWater) {
+        HighWater = used + 1;
+    }
+
+    slot = &EventBuffer[head & EVENT_QUEUE_MASK];
+    slot->type = (uint8_t)type;
+    slot->param = param;
+    slot->data = data;
+
+    __DMB();  // дٷ
+    EventHead = head + 1;
+    return 1;
+}
+
+/**
+  * @brief  ȡһ¼ѭеã
+  * @retval 1: ȡ¼  0: п
+  */
+uint8_t EventQueue_Get(Event_t* event)
+{
+    uint8_t tail = EventTail;
+
+    if(tail == EventHead) return 0;
+
+    __DMB();  // ȷٶ
+    *event = EventBuffer[tail & EVENT_QUEUE_MASK];
+    EventTail = tail + 1;
+    return 1;
+}
+
+/**
+  * @brief  Ƿδַ¼ǰ飩
+  */
+uint8_t EventQueue_IsPending(void)
+{
+    return (EventHead != EventTail);
+}
+
+/**
+  * @brief  ַеȫ¼ѭģ
+  */
+void EventQueue_Dispatch(void)
+{
+    Event_t event;
+
+    while(EventQueue_Get(&event)) {
+        if(event.type < EVENT_TYPE_MAX && EventHandlers[event.type] != 0) {
+            EventHandlers[event.type](&event);
+        }
+    }
+}
+
+/**
+  * @brief  ȡ¼
+  */
+uint32_t EventQueue_GetOverflowCount(void)
+{
+    return OverflowCount;
+}
+
+/**
+  * @brief  ȡѹȣгǷ㹻
+  */
+uint8_t EventQueue_GetHighWater(void)
+{
+    return HighWater;
+}
@@ -0,0 +1,52 @@
+//event_queue.h
+
+#ifndef __EVENT_QUEUE_H
+#define __EVENT_QUEUE_H
+
+#include "sc32f1xxx.h"
+
+/** @defgroup ¼ض
+  * @{
+  */
+#define EVENT_QUEUE_SIZE         16      // ȣ2ݣ
+
+/** @}
+  */
+
+/* ¼ͣжͶݣѭзַ */
+typedef enum {
+    EVENT_NONE = 0,
+    EVENT_KEY,                // ¼param: Key_IDϼΪ룩data: Key_Event
+    EVENT_OVERLOAD_TRIP,      // ȽӲش
+    EVENT_BATCH_MEASURED,     // װɼ
+    EVENT_BTM_TICK,           // BTMƵʱж
+    EVENT_UART_RX,            // յݣparam: ֽ
+    EVENT_TIMER_DUE,          // ʱ
+    EVENT_TYPE_MAX
+} EventType;
+
+/** @brief ¼4ֽڣжֻ */
+typedef struct {
+    uint8_t type;             // EventType
+    uint8_t param;            // СIDֽڵȣ
+    uint16_t data;            // ݣֵȣ
+} Event_t;
+
+/** @brief ¼ѭеã */
+typedef void (*Event_Handler)(const Event_t* event);
+
+/* ʼͶ */
+void EventQueue_Init(void);
+void EventQueue_Subscribe(EventType type, Event_Handler handler);
+
+/* Ͷݣжеãַѭеã */
+uint8_t EventQueue_Post(EventType type, uint8_t param, uint16_t data);
+uint8_t EventQueue_Get(Event_t* event);
+uint8_t EventQueue_IsPending(void);
+void EventQueue_Dispatch(void);
+
+/*  */
+uint32_t EventQueue_GetOverflowCount(void);
+uint8_t EventQueue_GetHighWater(void);
+
+#endif /* __EVENT_QUEUE_H */
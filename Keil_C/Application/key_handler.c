@@ -2,8 +2,53 @@
 
 #include "key_handler.h"
 #include "scale_manager.h"
-#include "weight_sensor.h"
+#include "system_timer.h"
 #include "buzzer.h"
+#include "event_queue.h"
+
+/**
+  * @brief  ɨصSysTickжϣֻͶ¼ҵѭн
+  */
+void Key_EventISR(uint8_t id, Key_Event event)
+{
+    EventQueue_Post(EVENT_KEY, id, (uint16_t)event);
+}
+
+/**
+  * @brief  ϼ
+  */
+static void Key_Chord_Handler(uint8_t keyMask)
+{
+    ResetInactivityTimer();
+
+    if(OverweightAlarm_Acknowledge()) {
+        Buzzer_Beep(20);
+        return;
+    }
+
+    if(keyMask == (KEY_MASK(KEY_ID_TARE) | KEY_MASK(KEY_ID_CALIB))) {
+        Scale_PostEvent(SCALE_EVT_KEY_CALIB_CHORD);   // ȥƤ+У׼У׼
+    } else if(keyMask == (KEY_MASK(KEY_ID_TARE) | KEY_MASK(KEY_ID_MEASURE))) {
+        Scale_PostEvent(SCALE_EVT_KEY_BATCH_CHORD);   // ȥƤ+ʼװ
+    }
+}
+
+/**
+  * @brief  ¼ѭģ
+  */
+void Key_EventHandler(const Event_t* event)
+{
+    switch((Key_Event)event->data) {
+        case KEY_EVENT_PRESS:
+            Key_Pressed_Handler((Key_ID)event->param);
+            break;
+        case KEY_EVENT_CHORD:
+            Key_Chord_Handler(event->param);
+            break;
+        default:
+            break;
+    }
+}
 
 /**
   * @brief  »ص
@@ -13,44 +58,24 @@ void Key_Pressed_Handler(Key_ID keyId)
     // κΰ¶޲ʱ
     ResetInactivityTimer();
     
+    // ĳرⰴȷϣΰִ
+    if(OverweightAlarm_Acknowledge()) {
+        Buzzer_Beep(20);
+        return;
+    }
+    
     switch(keyId) {
-        case KEY_ID_TARE:
-            if(Scale_State.isMeasuring) {
-                // ģʽµĶ
-                if(Scale_State.overweightMode == OVERWEIGHT_KEY_CHECK) {
-                    if(OverweightCheck_OnKeyPress()) {
-                        Buzzer_Beep(20);  // ̴ʾزȥƤ
-                        break;
-                    }
-                }
-                WeightSensor_Tare();  // ȥƤ
-                Buzzer_Beep(50);
-            } else {
-                Buzzer_Beep(20);  // ̴ʾδ
-            }
-            break;
-        case KEY_ID_CALIB:  // У׼
-            Buzzer_Beep(100);
+        case KEY_ID_TARE:     // ȥƤ
+            Scale_PostEvent(SCALE_EVT_KEY_TARE);
+            break;
+        case KEY_ID_CALIB:    // У׼
+            Scale_PostEvent(SCALE_EVT_KEY_CALIB);
             break;
         case KEY_ID_MEASURE:  // /ֹͣ
-            // ģʽµĳؼ
-            if(Scale_State.overweightMode == OVERWEIGHT_KEY_CHECK) {
-                if(OverweightCheck_OnKeyPress()) {
-                    Buzzer_Beep(20);  // ̴ʾز
-                    break;
-                }
-            }
-            
-            Scale_State.isMeasuring = !Scale_State.isMeasuring;
-            if(Scale_State.isMeasuring) {
-                Buzzer_Beep(100);  // ʾʼ
-            } else {
-                Buzzer_Beep(30);   // ʾֹͣ
-                StopAlarm();       // ֹͣʱҲֹͣ
-            }
-            break;
-        case KEY_ID_POWER:    // ռλ¹
-            Buzzer_Beep(80);
+            Scale_PostEvent(SCALE_EVT_KEY_MEASURE);
+            break;
+        case KEY_ID_POWER:    // Դ
+            Scale_PostEvent(SCALE_EVT_KEY_POWER);
             break;
         default:
             break;
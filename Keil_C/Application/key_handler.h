@@ -5,8 +5,11 @@
 
 #include "sc32f1xxx.h"
 #include "key.h"
+#include "event_queue.h"
 
 /*  */
 void Key_Pressed_Handler(Key_ID keyId);
+void Key_EventISR(uint8_t id, Key_Event event);
+void Key_EventHandler(const Event_t* event);
 
 #endif /* __KEY_HANDLER_H */
@@ -0,0 +1,177 @@
+//mem_monitor.c
+
+#include "mem_monitor.h"
+#include "ram_code.h"
+#include "debug_uart.h"
+#include "debug_console.h"
+
+#define MEM_RAM_BASE     0x20000000U      // Project/elec_scale.sctһ
+#define MEM_RAM_SIZE     0x00004000U      // 16KBSRAM_SIZE_MAX
+
+/* ɵ */
+#if defined(__CC_ARM) || (defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))
+extern uint32_t STACK$$Base;                      // ļSTACK
+extern uint32_t STACK$$Limit;
+extern uint32_t HEAP$$Base;                       // ļHEAP
+extern uint32_t HEAP$$Limit;
+extern uint32_t Image$$RW_IRAM1$$RW$$Length;
+extern uint32_t Image$$RW_IRAM1$$ZI$$Length;
+#define MEM_STACK_BASE   ((uint32_t)&STACK$$Base)
+#define MEM_STACK_TOP    ((uint32_t)&STACK$$Limit)
+#define MEM_HEAP_SIZE    ((uint32_t)&HEAP$$Limit - (uint32_t)&HEAP$$Base)
+#define MEM_RW_LENGTH    ((uint32_t)&Image$$RW_IRAM1$$RW$$Length)
+#define MEM_ZI_LENGTH    ((uint32_t)&Image$$RW_IRAM1$$ZI$$Length)
+#elif defined(__GNUC__) && defined(__arm__)
+extern uint32_t __StackLimit, __StackTop;         // CMSIS GCCӽű
+extern uint32_t __HeapBase, __HeapLimit;
+extern uint32_t __data_start__, __data_end__;
+extern uint32_t __bss_start__, __bss_end__;
+#define MEM_STACK_BASE   ((uint32_t)&__StackLimit)
+#define MEM_STACK_TOP    ((uint32_t)&__StackTop)
+#define MEM_HEAP_SIZE    ((uint32_t)&__HeapLimit - (uint32_t)&__HeapBase)
+#define MEM_RW_LENGTH    ((uint32_t)&__data_end__ - (uint32_t)&__data_start__ - RamCode_GetSize())
+#define MEM_ZI_LENGTH    ((uint32_t)&__bss_end__ - (uint32_t)&__bss_start__ + MEM_HEAP_SIZE + MEM_STACK_SIZE)
+#else
+#define MEM_STACK_BASE   0U
+#define MEM_STACK_TOP    0U
+#define MEM_HEAP_SIZE    0U
+#define MEM_RW_LENGTH    0U
+#define MEM_ZI_LENGTH    0U
+#endif
+
+#define MEM_STACK_SIZE   (MEM_STACK_TOP - MEM_STACK_BASE)
+
+/** @brief Ǽǵģ龲̬RAM */
+typedef struct {
+    const char* Name;
+    uint32_t Bytes;
+} Mem_ModuleTypeDef;
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static Mem_ModuleTypeDef Mem_Modules[MEM_MONITOR_MAX_MODULES];
+static uint8_t Mem_ModuleCount = 0;
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  ͼ䵱ǰSPµջmain()ͷãʱջֻ˺һ֣
+  */
+void MemMonitor_PaintStack(void)
+{
+    volatile uint32_t* p = (volatile uint32_t*)MEM_STACK_BASE;
+    uint32_t* end = (uint32_t*)(__get_MSP() - MEM_STACK_PAINT_MARGIN);
+
+    while(p < end) {
+        *p++ = MEM_STACK_PAINT_PATTERN;
+    }
+}
+
+/**
+  * @brief  ڴӳʼעᴮ m(ڴ汨)
+  */
+void MemMonitor_Init(void)
+{
+    DebugConsole_AddCommand('m', MemMonitor_Dump, "memory report");
+}
+
+/**
+  * @brief  ǼģҪ̬RAMռãģʼʱãsizeof㣩
+  */
+void MemMonitor_AddModule(const char* name, uint32_t bytes)
+{
+    if(Mem_ModuleCount >= MEM_MONITOR_MAX_MODULES) return;
+
+    Mem_Modules[Mem_ModuleCount].Name = name;
+    Mem_Modules[Mem_ModuleCount].Bytes = bytes;
+    Mem_ModuleCount++;
+}
+
+/**
+  * @brief  ջʷʹֽڣջϲҵһд
+  */
+uint32_t MemMonitor_GetStackPeak(void)
+{
+    const uint32_t* p = (const uint32_t*)MEM_STACK_BASE;
+    const uint32_t* top = (const uint32_t*)MEM_STACK_TOP;
+
+    while(p < top && *p == MEM_STACK_PAINT_PATTERN) {
+        p++;
+    }
+    return (uint32_t)(top - p) * sizeof(uint32_t);
+}
+
+/**
+  * @brief  ջǰʹֽڣ
+  */
+uint32_t MemMonitor_GetStackUsedNow(void)
+{
+    return MEM_STACK_TOP - __get_MSP();
+}
+
+/**
+  * @brief  ȡRAMռøſ
+  */
+void MemMonitor_GetUsage(Mem_UsageTypeDef* usage)
+{
+    usage->RamSize = MEM_RAM_SIZE;
+    usage->RamCode = RamCode_GetSize();
+    usage->RwData = MEM_RW_LENGTH;
+    usage->ZiData = MEM_ZI_LENGTH;
+    usage->StackSize = MEM_STACK_SIZE;
+    usage->StackPeak = MemMonitor_GetStackPeak();
+    usage->HeapSize = MEM_HEAP_SIZE;
+}
+
+/**
+  * @brief  һ  ֽ
+  */
+static void MemMonitor_WriteItem(const char* name, uint32_t bytes)
+{
+    DebugUart_WriteChar(' ');
+    DebugUart_WriteString(name);
+    DebugUart_WriteChar(' ');
+    DebugUart_WriteUint(bytes);
+    DebugUart_WriteNewLine();
+}
+
+/**
+  * @brief  ͨԴڴ汨棺RAMջֵģǼǵľ̬RAM
+  */
+void MemMonitor_Dump(void)
+{
+    Mem_UsageTypeDef usage;
+    uint32_t used, registered = 0;
+
+    MemMonitor_GetUsage(&usage);
+    used = usage.RamCode + usage.RwData + usage.ZiData;
+
+    DebugUart_WriteString("ram (bytes)");
+    DebugUart_WriteNewLine();
+    MemMonitor_WriteItem("total", usage.RamSize);
+    MemMonitor_WriteItem("ramcode", usage.RamCode);
+    MemMonitor_WriteItem("rw", usage.RwData);
+    MemMonitor_WriteItem("zi", usage.ZiData);
+    MemMonitor_WriteItem("free", (used < usage.RamSize) ? usage.RamSize - used : 0);
+
+    DebugUart_WriteString("stack");
+    DebugUart_WriteNewLine();
+    MemMonitor_WriteItem("size", usage.StackSize);
+    MemMonitor_WriteItem("peak", usage.StackPeak);
+    MemMonitor_WriteItem("now", MemMonitor_GetStackUsedNow());
+    MemMonitor_WriteItem("heap", usage.HeapSize);
+
+    DebugUart_WriteString("modules");
+    DebugUart_WriteNewLine();
+    for(uint8_t i = 0; i < Mem_ModuleCount; i++) {
+        MemMonitor_WriteItem(Mem_Modules[i].Name, Mem_Modules[i].Bytes);
+        registered += Mem_Modules[i].Bytes;
+    }
+
+    /* ջͶ֮⡢δǼǵľ̬ */
+    used = usage.RwData + usage.ZiData - usage.StackSize - usage.HeapSize;
+    MemMonitor_WriteItem("other", (used > registered) ? used - registered : 0);
+}
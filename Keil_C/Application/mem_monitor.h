@@ -0,0 +1,42 @@
+//mem_monitor.h
+
+#ifndef __MEM_MONITOR_H
+#define __MEM_MONITOR_H
+
+#include "sc32f1xxx.h"
+
+/** @defgroup ڴض
+  * @{
+  */
+#define MEM_STACK_PAINT_PATTERN   0xCDCDCDCDU   // ջͼ
+#define MEM_STACK_PAINT_MARGIN    16            // ʱڵǰSP·ֽ
+#define MEM_MONITOR_MAX_MODULES   10            // Ǽǵģ
+
+/** @}
+  */
+
+/** @brief RAMռøſֽڣ */
+typedef struct {
+    uint32_t RamSize;           // SRAM
+    uint32_t RamCode;           // SRAMִд
+    uint32_t RwData;            // гֵ
+    uint32_t ZiData;            // ֵջͶѣ
+    uint32_t StackSize;         // ջС
+    uint32_t StackPeak;         // ջʷʹͼдȣ
+    uint32_t HeapSize;          // ѴС
+} Mem_UsageTypeDef;
+
+/* ʱãmain()ʼж֮ǰջ */
+void MemMonitor_PaintStack(void);
+
+/* ʼ͵ǼǺ */
+void MemMonitor_Init(void);
+void MemMonitor_AddModule(const char* name, uint32_t bytes);
+
+/* ѯ */
+uint32_t MemMonitor_GetStackPeak(void);
+uint32_t MemMonitor_GetStackUsedNow(void);
+void MemMonitor_GetUsage(Mem_UsageTypeDef* usage);
+void MemMonitor_Dump(void);
+
+#endif /* __MEM_MONITOR_H */
@@ -0,0 +1,171 @@
+//num_format.c
+
+#include "num_format.h"
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static const uint32_t NumFormat_Pow10[NUMFMT_MAX_DIGITS] = {
+    1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U
+};
+
+/* 0-9 */
+static const uint8_t NumFormat_Font[10] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+};
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  ȡֵINT32_MINҲȷת
+  */
+static uint32_t NumFormat_Magnitude(int32_t value)
+{
+    return (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+}
+
+/**
+  * @brief  λ10ȡʮ֣M0+ûгָÿλ9Σ
+  * @param  digits: countλdigits[0]Ϊλ
+  * @retval 1: valueС10^countλص
+  */
+uint8_t NumFormat_Digits(uint32_t value, uint8_t* digits, uint8_t count)
+{
+    uint8_t overflow = 0;
+    uint8_t d;
+
+    for(uint8_t i = NUMFMT_MAX_DIGITS; i-- > 0; ) {
+        d = 0;
+        while(value >= NumFormat_Pow10[i]) {
+            value -= NumFormat_Pow10[i];
+            d++;
+        }
+        if(i < count) {
+            digits[count - 1 - i] = d;
+        } else if(d != 0) {
+            overflow = 1;
+        }
+    }
+    return overflow;
+}
+
+/**
+  * @brief  ʾֶ루ֵ0.5ֶȽλ
+  * @param  step: ֶϵ1/2/5
+  * @param  exp: ֶΪstep10^expСλ0-8
+  */
+int32_t NumFormat_Round(int32_t value, uint8_t step, uint8_t exp)
+{
+    uint32_t mag = NumFormat_Magnitude(value);
+    uint32_t division = step * NumFormat_Pow10[exp];
+    uint32_t residual = mag;
+
+    /* 10^(exp+1)Ƿֶȵȥλټȥֶȵõ */
+    for(uint8_t i = NUMFMT_MAX_DIGITS - 1; i > exp; i--) {
+        while(residual >= NumFormat_Pow10[i]) residual -= NumFormat_Pow10[i];
+    }
+    while(residual >= division) residual -= division;
+
+    mag -= residual;
+    if(residual >= division - residual && mag <= 0x7FFFFFFFU - division) {
+        mag += division;
+    }
+    return (value < 0) ? (int32_t)(0U - mag) : (int32_t)mag;
+}
+
+/**
+  * @brief  ɶ룺ȥshiftλѰֶȡΪ0decimalsλСǰ
+  * @retval widthλʱNUMFMT_OVERFLOW
+  */
+static uint8_t NumFormat_Render(uint32_t mag, uint8_t shift, uint8_t decimals, uint8_t* segs, uint8_t width)
+{
+    uint8_t digits[NUMFMT_MAX_DIGITS];
+    uint8_t blank = 1;
+    uint8_t pos;
+
+    if(decimals >= width || width + shift > NUMFMT_MAX_DIGITS ||
+       NumFormat_Digits(mag, digits, width + shift)) {
+        for(uint8_t i = 0; i < width; i++) {
+            segs[i] = NUMFMT_SEG_MINUS;
+        }
+        return NUMFMT_OVERFLOW;
+    }
+
+    for(uint8_t i = 0; i < width; i++) {
+        pos = width - 1 - i;   // ӸλСʱΪСλλ
+        if(blank && digits[i] == 0 && pos > decimals) {
+            segs[i] = 0;
+        } else {
+            blank = 0;
+            segs[i] = NumFormat_Font[digits[i]];
+        }
+        if(pos == decimals && decimals != 0) segs[i] |= NUMFMT_SEG_DP;
+    }
+    return 0;
+}
+
+/**
+  * @brief  תΪ7ζ룬Ҷ룬segs[0]Ϊһλ
+  * @param  value: ʾֵѰСλŴʾ12.3ʱ1231
+  * @retval NUMFMT_NEGATIVE / NUMFMT_OVERFLOW
+  */
+uint8_t NumFormat_Segments(int32_t value, uint8_t decimals, uint8_t* segs, uint8_t width)
+{
+    uint8_t flags = NumFormat_Render(NumFormat_Magnitude(value), 0, decimals, segs, width);
+
+    return (value < 0) ? (flags | NUMFMT_NEGATIVE) : flags;
+}
+
+/**
+  * @brief  תΪҶASCIIַźС㣬ಹո
+  * @param  buf: width+1ֽڣ'\0'β
+  * @retval NUMFMT_NEGATIVE / NUMFMT_OVERFLOWϣʱ'-'
+  */
+uint8_t NumFormat_Ascii(int32_t value, uint8_t decimals, char* buf, uint8_t width)
+{
+    uint8_t digits[NUMFMT_MAX_DIGITS];
+    uint8_t flags = (value < 0) ? NUMFMT_NEGATIVE : 0;
+    uint8_t count = NUMFMT_MAX_DIGITS;
+    uint8_t pos = width;
+
+    NumFormat_Digits(NumFormat_Magnitude(value), digits, NUMFMT_MAX_DIGITS);
+    while(count > 1 && digits[NUMFMT_MAX_DIGITS - count] == 0) count--;
+    if(count <= decimals) count = decimals + 1;
+
+    buf[width] = '\0';
+    if(decimals >= NUMFMT_MAX_DIGITS ||
+       count + (decimals != 0) + (flags & NUMFMT_NEGATIVE) > width) {
+        while(pos > 0) buf[--pos] = '-';
+        return flags | NUMFMT_OVERFLOW;
+    }
+
+    for(uint8_t k = 0; k < count; k++) {
+        if(k == decimals && decimals != 0) buf[--pos] = '.';
+        buf[--pos] = (char)('0' + digits[NUMFMT_MAX_DIGITS - 1 - k]);
+    }
+    if(flags & NUMFMT_NEGATIVE) buf[--pos] = '-';
+    while(pos > 0) buf[--pos] = ' ';
+    return flags;
+}
+
+/**
+  * @brief  תΪ룺gstep0.1gȡʾ1λСλʱkgstep1gȡʾ3λС
+  * @param  milligram: (mg)
+  * @param  unit: ʾλ
+  * @retval NUMFMT_NEGATIVE / NUMFMT_OVERFLOWϣȡΪ0㸺
+  */
+uint8_t NumFormat_Weight(int32_t milligram, uint8_t step, uint8_t* segs, uint8_t width, NumFormat_Unit* unit)
+{
+    int32_t rounded = NumFormat_Round(milligram, step, 2);
+    uint8_t flags = NumFormat_Render(NumFormat_Magnitude(rounded), 2, 1, segs, width);
+
+    *unit = NUMFMT_UNIT_G;
+    if(flags & NUMFMT_OVERFLOW) {
+        rounded = NumFormat_Round(milligram, step, 3);
+        flags = NumFormat_Render(NumFormat_Magnitude(rounded), 3, 3, segs, width);
+        *unit = NUMFMT_UNIT_KG;
+    }
+    return (rounded < 0) ? (flags | NUMFMT_NEGATIVE) : flags;
+}
@@ -0,0 +1,39 @@
+//num_format.h
+
+#ifndef __NUM_FORMAT_H
+#define __NUM_FORMAT_H
+
+#include "sc32f1xxx.h"
+
+/** @defgroup ָʽض
+  * @{
+  */
+#define NUMFMT_MAX_DIGITS        10      // uint32_t10λʮ
+
+/* 7λλ0..7Ϊa b c d e f g dp */
+#define NUMFMT_SEG_MINUS         0x40U   // ߣg
+#define NUMFMT_SEG_DP            0x80U   // С
+
+/* ʽ־ */
+#define NUMFMT_NEGATIVE          0x01U   // ţɵߵŷţ
+#define NUMFMT_OVERFLOW          0x02U   // ʾλΪ
+
+/** @}
+  */
+
+/* ʾλ */
+typedef enum {
+    NUMFMT_UNIT_G = 0,
+    NUMFMT_UNIT_KG
+} NumFormat_Unit;
+
+/* 㣨ֻüӼλó⣩ */
+uint8_t NumFormat_Digits(uint32_t value, uint8_t* digits, uint8_t count);
+int32_t NumFormat_Round(int32_t value, uint8_t step, uint8_t exp);
+
+/* ṩĻ */
+uint8_t NumFormat_Segments(int32_t value, uint8_t decimals, uint8_t* segs, uint8_t width);
+uint8_t NumFormat_Ascii(int32_t value, uint8_t decimals, char* buf, uint8_t width);
+uint8_t NumFormat_Weight(int32_t milligram, uint8_t step, uint8_t* segs, uint8_t width, NumFormat_Unit* unit);
+
+#endif /* __NUM_FORMAT_H */
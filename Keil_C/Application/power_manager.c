@@ -0,0 +1,280 @@
+//power_manager.c
+
+#include "power_manager.h"
+#include "system_timer.h"
+#include "event_queue.h"
+#include "weight_sensor.h"
+#include "buzzer.h"
+#include "clock_manager.h"
+#include "supervisor.h"
+#include "key.h"
+#include "scale_manager.h"
+#include "oled.h"
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static Power_InitTypeDef Power_Config;
+static Power_StatsTypeDef Power_Stats = {0};
+static volatile uint8_t Standby = 0;             // Уѹرգ
+static uint8_t StopEntered = 0;                   // ϸBTMڽSTOPSysTickֹͣ
+static uint32_t BtmTickMs = 0;                    // ϸBTMڿʼʱϵͳʱ
+static uint8_t WakeMeasurePending = 0;            // ˳ȴ׸ͻ
+
+/* λ */
+static const Power_ProfileTypeDef Power_Profiles[POWER_PROFILE_MAX] = {
+    {   0,  0,   0 },   // 
+    { 100, 16, 500 },   // ÿ10ζ
+    { 500,  8, 500 },   // ÿ2ζ
+};
+static Power_Profile CurrentProfile = POWER_PROFILE_CONTINUOUS;
+static Interval_Ms BurstInterval;                 // ͻ
+static uint32_t MeasuredBurstUs[POWER_PROFILE_MAX]; // λʵͻʱ
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  BTM¼ѭģSTOPڼSysTickֹͣBTMڲϵͳʱ
+  * @note   ֻIDLEʱSysTickһֱڼʱ
+  *         ʱIDLE簴ɨ衢ʾʱֻSysTickټƵĲ
+  */
+static void Power_BTMEventHandler(const Event_t* event)
+{
+    uint32_t countedMs;
+
+    (void)event;
+    if(!Standby) return;
+
+    if(StopEntered) {
+        StopEntered = 0;
+        countedMs = GetSystemTimeMs() - BtmTickMs;
+        if(countedMs < Power_Config.WakeIntervalMs) {
+            SystemTimer_AdvanceMs(Power_Config.WakeIntervalMs - countedMs);
+        }
+    }
+    BtmTickMs = GetSystemTimeMs();
+}
+
+/**
+  * @brief  ¼һλʱ䣨ǰ׸Ч
+  */
+static void Power_RecordWake(uint32_t wakeUs)
+{
+    Power_Stats.LastWakeUs = wakeUs;
+    if(wakeUs > Power_Stats.MaxWakeUs) {
+        Power_Stats.MaxWakeUs = wakeUs;
+    }
+    if(wakeUs > Power_Config.WakeTargetUs) {
+        Power_Stats.WakeTargetMisses++;
+    }
+}
+
+/**
+  * @brief  ͹Ĺʼ
+  */
+void PowerManager_Init(Power_InitTypeDef* Power_InitStruct)
+{
+    Power_Config = *Power_InitStruct;
+
+    /* BTMֻڴʱУΪڻԴ */
+    BTM_Cmd(BTM, DISABLE);
+    BTM_FSConfig(BTM, Power_Config.WakeInterval);
+    BTM_ITConfig(BTM, BTM_IT_INT, ENABLE);
+    NVIC_EnableIRQ(BTM_IRQn);
+
+    EventQueue_Subscribe(EVENT_BTM_TICK, Power_BTMEventHandler);
+
+    PowerManager_SetProfile(Power_Config.Profile);
+}
+
+/**
+  * @brief  лλ
+  */
+void PowerManager_SetProfile(Power_Profile profile)
+{
+    if(profile >= POWER_PROFILE_MAX) return;
+
+    CurrentProfile = profile;
+    if(Power_Profiles[profile].IntervalMs == 0) {
+        /* ָ˷/ADC˲ */
+        if(!Standby) WeightSensor_PowerUp();
+    } else {
+        /* ͻͻ֮˷/ADCϵ */
+        WeightSensor_PowerDown();
+        Interval_Start(&BurstInterval, Power_Profiles[profile].IntervalMs);
+    }
+}
+
+/**
+  * @brief  ȡǰλ
+  */
+Power_Profile PowerManager_GetProfile(void)
+{
+    return CurrentProfile;
+}
+
+/**
+  * @brief  ִһͻ¼ʱ
+  * @note   ˳ĵһͻǰͬʱ뻽ͳ
+  */
+static uint32_t Power_Burst(void)
+{
+    const Power_ProfileTypeDef* profile = &Power_Profiles[CurrentProfile];
+    Time_Us start = Time_NowUs();
+    uint32_t count = WeightSensor_ReadBurst(profile->BurstSamples, profile->SettleUs);
+
+    MeasuredBurstUs[CurrentProfile] = Time_ElapsedUs(start);
+    if(WakeMeasurePending) {
+        WakeMeasurePending = 0;
+        Power_RecordWake(MeasuredBurstUs[CurrentProfile]);
+    }
+    return count;
+}
+
+/**
+  * @brief  ǰλȡڵã
+  * @param  weight: ¶(g)
+  * @retval 1: ¶  0: ͻδ˷/ADCֶϵ
+  */
+uint8_t PowerManager_ReadWeight(float* weight)
+{
+    if(Power_Profiles[CurrentProfile].IntervalMs == 0) {
+        *weight = WeightSensor_GetWeightGram();
+        return 1;
+    }
+    if(!Interval_IsDue(&BurstInterval)) return 0;
+
+    *weight = WeightSensor_CountToGram(Power_Burst());
+    return 1;
+}
+
+/**
+  * @brief  ȡȳϣȴͻ
+  */
+float PowerManager_ReadWeightNow(void)
+{
+    if(Power_Profiles[CurrentProfile].IntervalMs == 0) {
+        return WeightSensor_GetWeightGram();
+    }
+    return WeightSensor_CountToGram(Power_Burst());
+}
+
+/**
+  * @brief  λĶʺƽ
+  * @note   ͻʱʵֵʱʹʵֵתʱ㣻
+  *         ͻ֮ں˴IDLESysTickʱҪ
+  */
+void PowerManager_GetProfileReport(Power_Profile profile, Power_ProfileReportTypeDef* report)
+{
+    const Power_ProfileTypeDef* cfg;
+    uint32_t burstUs, intervalUs, activeUa;
+
+    if(profile >= POWER_PROFILE_MAX) return;
+    cfg = &Power_Profiles[profile];
+
+    if(cfg->IntervalMs == 0) {
+        /* ˷/ADCÿ״̬һ뻬 */
+        report->ReadingsPerSecondX100 = 100000 / POWER_CONTINUOUS_READ_MS;
+        report->BurstUs = 0;
+        report->AverageCurrentUa = POWER_EST_IDLE_UA + POWER_EST_OP_UA + POWER_EST_ADC_UA;
+        report->ResponseMs = (uint32_t)WEIGHT_SAMPLE_BUFFER_SIZE * POWER_CONTINUOUS_READ_MS;
+        return;
+    }
+
+    burstUs = MeasuredBurstUs[profile];
+    if(burstUs == 0) {
+        burstUs = cfg->SettleUs + (uint32_t)(cfg->BurstSamples + WEIGHT_BURST_DISCARD) * POWER_EST_ADC_CONV_US;
+    }
+    intervalUs = cfg->IntervalMs * 1000;
+    activeUa = POWER_EST_RUN_UA - POWER_EST_IDLE_UA + POWER_EST_OP_UA + POWER_EST_ADC_UA;
+
+    report->ReadingsPerSecondX100 = 100000 / cfg->IntervalMs;
+    report->BurstUs = burstUs;
+    report->ResponseMs = cfg->IntervalMs;
+    report->AverageCurrentUa = POWER_EST_IDLE_UA +
+                               (uint32_t)(((uint64_t)activeUa * burstUs) / intervalUs);
+}
+
+/**
+  * @brief  ر˷źADCBTMڻ
+  * @note   ڽеʾճPWM֮رգ֮ŽSTOP
+  */
+void PowerManager_EnterStandby(void)
+{
+    if(Standby) return;
+
+    WeightSensor_PowerDown();
+    StopEntered = 0;
+    BtmTickMs = GetSystemTimeMs();
+    BTM_Cmd(BTM, ENABLE);
+    ClockManager_SetLowSpeed(1);
+    Supervisor_Suspend();               // BTMѼŹʱ
+
+    Power_Stats.StandbyCount++;
+    Standby = 1;
+}
+
+/**
+  * @brief  ˳ָ貢˲ͳǰ׸Чʱ
+  * @note   ͳƲѰȷϺŵñ
+  */
+void PowerManager_ExitStandby(void)
+{
+    Time_Us start;
+
+    if(!Standby) return;
+
+    Standby = 0;
+    ClockManager_SetLowSpeed(0);
+    Supervisor_Resume();
+    BTM_Cmd(BTM, DISABLE);
+    if(Power_Profiles[CurrentProfile].IntervalMs == 0) {
+        /* ˷/ADCϵ磬˲ɼõЧ */
+        start = Time_NowUs();
+        WeightSensor_PowerUp();
+        Power_RecordWake(Time_ElapsedUs(start));
+    } else {
+        /* ͻ´εͻĺʱͳ */
+        BurstInterval.next = Time_NowMs();
+        WakeMeasurePending = 1;
+    }
+}
+
+/**
+  * @brief  Ƿڴ
+  */
+uint8_t PowerManager_IsStandby(void)
+{
+    return Standby;
+}
+
+/**
+  * @brief  лصж״̬µã
+  * @note   STOPģʽSysTickֹͣINTBTMжϻѣ
+  *         ڼҪSysTickʱֻIDLE
+  */
+void PowerManager_IdleHook(void)
+{
+    uint8_t displayBusy = 0;
+    
+#if DISPLAY_TYPE == DISPLAY_GRAPHIC
+    /* STOPжʾDMAη */
+    displayBusy = Oled_IsBusy();
+#endif
+    if(Standby && !Buzzer_IsActive() && !Key_IsScanning() && !displayBusy) {
+        PWR_EnterSTOPMode(PWR_STOPEntry_WFI);
+        StopEntered = 1;
+    } else {
+        PWR_EnterIDLEMode(PWR_IDLEEntry_WFI);
+    }
+}
+
+/**
+  * @brief  ȡͳ
+  */
+const Power_StatsTypeDef* PowerManager_GetStats(void)
+{
+    return &Power_Stats;
+}
@@ -0,0 +1,81 @@
+//power_manager.h
+
+#ifndef __POWER_MANAGER_H
+#define __POWER_MANAGER_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_btm.h"
+#include "sc32f1xxx_pwr.h"
+
+/** @defgroup ĹֵʵӲϲ
+  * @{
+  */
+#define POWER_EST_RUN_UA         4000    // ںе(uA)
+#define POWER_EST_IDLE_UA        1200    // IDLEģʽ(uA)
+#define POWER_EST_OP_UA          350     // ˷Ź(uA)
+#define POWER_EST_ADC_UA         600     // ADC(uA)
+#define POWER_EST_ADC_CONV_US    20      // תʱ(us)
+#define POWER_CONTINUOUS_READ_MS 20      // ʱĶڣapp_init.cеӳ״̬һ£
+
+/** @}
+  */
+
+/* ĵλͻλ˷ͻ֮ϵ磬ȽӲر֮ʧЧ */
+typedef enum {
+    POWER_PROFILE_CONTINUOUS = 0,   // ˷/ADC˲
+    POWER_PROFILE_BALANCED,         // 100msͻ
+    POWER_PROFILE_ECO,              // 500msͻ
+    POWER_PROFILE_MAX
+} Power_Profile;
+
+/** @brief λ */
+typedef struct {
+    uint32_t IntervalMs;            // ͻ(ms)0ʾ
+    uint8_t BurstSamples;           // ÿͻЧ
+    uint32_t SettleUs;              // ˷ϵ罨ʱ(us)
+} Power_ProfileTypeDef;
+
+/** @brief λ */
+typedef struct {
+    uint32_t ReadingsPerSecondX100; // Чʣ/ x100
+    uint32_t BurstUs;               // ͻʱ(us)ѲʱΪʵֵ
+    uint32_t AverageCurrentUa;      // ƽ(uA)
+    uint32_t ResponseMs;            // Ծȫӳʱ(ms)
+} Power_ProfileReportTypeDef;
+
+/** @brief ͹Ĺýṹ */
+typedef struct {
+    Power_Profile Profile;                 // ʼλ
+    BTM_FreqSelect_TypeDef WakeInterval;   // ʱBTM
+    uint32_t WakeIntervalMs;               // WakeIntervalӦĺڼ䲹ϵͳʱ䣩
+    uint32_t WakeTargetUs;                 // ǰ׸ЧĿʱ(us)
+} Power_InitTypeDef;
+
+/** @brief ͳ */
+typedef struct {
+    uint32_t StandbyCount;                 // 
+    uint32_t LastWakeUs;                   // ϴǰ׸Чʱ(us)
+    uint32_t MaxWakeUs;                    // ʱ(us)
+    uint32_t WakeTargetMisses;             // ĿʱĴ
+} Power_StatsTypeDef;
+
+/* ʼͿƺ */
+void PowerManager_Init(Power_InitTypeDef* Power_InitStruct);
+void PowerManager_EnterStandby(void);
+void PowerManager_ExitStandby(void);
+uint8_t PowerManager_IsStandby(void);
+
+/* λ */
+void PowerManager_SetProfile(Power_Profile profile);
+Power_Profile PowerManager_GetProfile(void);
+uint8_t PowerManager_ReadWeight(float* weight);
+float PowerManager_ReadWeightNow(void);
+void PowerManager_GetProfileReport(Power_Profile profile, Power_ProfileReportTypeDef* report);
+
+/* лصʱSTOPģʽIDLEģʽ */
+void PowerManager_IdleHook(void);
+
+/* ͳ */
+const Power_StatsTypeDef* PowerManager_GetStats(void);
+
+#endif /* __POWER_MANAGER_H */
@@ -0,0 +1,135 @@
+//profiler.c
+
+#include "profiler.h"
+
+#if PROFILER_ENABLE
+
+#include "debug_uart.h"
+#include "debug_console.h"
+#include "mem_monitor.h"
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static Prof_StatsTypeDef Prof_Stats[PROF_REGION_MAX];
+
+static const char* const Prof_Names[PROF_REGION_MAX] = {
+    "scale_tick",
+    "display",
+    "overweight",
+    "adc_wait",
+    "filter",
+};
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  Ӧֱͼλfloor(log2(cycles))Χһ
+  */
+static uint8_t Profiler_Bin(uint32_t cycles)
+{
+    uint8_t bin = 0;
+
+    while(cycles > 1 && bin < PROFILER_HIST_BINS - 1) {
+        cycles >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+/**
+  * @brief  ͳƳʼעᴮ p() / r()
+  */
+void Profiler_Init(void)
+{
+    Profiler_Reset();
+    MemMonitor_AddModule("profiler", sizeof(Prof_Stats));
+    DebugConsole_AddCommand('p', Profiler_Dump, "profiler dump");
+    DebugConsole_AddCommand('r', Profiler_Reset, "profiler reset");
+}
+
+/**
+  * @brief  ¼һִ
+  */
+void Profiler_Record(Prof_Region region, uint32_t cycles)
+{
+    Prof_StatsTypeDef* stats;
+    uint8_t bin;
+
+    if(region >= PROF_REGION_MAX) return;
+
+    stats = &Prof_Stats[region];
+    stats->Count++;
+    stats->TotalCycles += cycles;
+    if(cycles < stats->MinCycles) stats->MinCycles = cycles;
+    if(cycles > stats->MaxCycles) stats->MaxCycles = cycles;
+
+    bin = Profiler_Bin(cycles);
+    if(stats->Histogram[bin] < 0xFFFF) stats->Histogram[bin]++;
+}
+
+/**
+  * @brief  ȡͳ
+  */
+const Prof_StatsTypeDef* Profiler_GetStats(Prof_Region region)
+{
+    if(region >= PROF_REGION_MAX) return 0;
+    return &Prof_Stats[region];
+}
+
+/**
+  * @brief  ȫͳ
+  */
+void Profiler_Reset(void)
+{
+    for(uint8_t i = 0; i < PROF_REGION_MAX; i++) {
+        Prof_StatsTypeDef* stats = &Prof_Stats[i];
+
+        stats->Count = 0;
+        stats->MinCycles = 0xFFFFFFFF;
+        stats->MaxCycles = 0;
+        stats->TotalCycles = 0;
+        for(uint8_t bin = 0; bin < PROFILER_HIST_BINS; bin++) {
+            stats->Histogram[bin] = 0;
+        }
+    }
+}
+
+/**
+  * @brief  ͨԴͳƣÿһ   С ƽ һֱͼ
+  */
+void Profiler_Dump(void)
+{
+    DebugUart_WriteString("region count min avg max (cycles)");
+    DebugUart_WriteNewLine();
+
+    for(uint8_t i = 0; i < PROF_REGION_MAX; i++) {
+        const Prof_StatsTypeDef* stats = &Prof_Stats[i];
+
+        DebugUart_WriteString(Prof_Names[i]);
+        DebugUart_WriteChar(' ');
+        DebugUart_WriteUint(stats->Count);
+        if(stats->Count == 0) {
+            DebugUart_WriteNewLine();
+            continue;
+        }
+        DebugUart_WriteChar(' ');
+        DebugUart_WriteUint(stats->MinCycles);
+        DebugUart_WriteChar(' ');
+        DebugUart_WriteUint((uint32_t)(stats->TotalCycles / stats->Count));
+        DebugUart_WriteChar(' ');
+        DebugUart_WriteUint(stats->MaxCycles);
+        DebugUart_WriteNewLine();
+
+        DebugUart_WriteString("  hist");
+        for(uint8_t bin = 0; bin < PROFILER_HIST_BINS; bin++) {
+            DebugUart_WriteChar(' ');
+            DebugUart_WriteUint(stats->Histogram[bin]);
+        }
+        DebugUart_WriteNewLine();
+    }
+}
+
+#endif /* PROFILER_ENABLE */
@@ -0,0 +1,62 @@
+//profiler.h
+
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#include "sc32f1xxx.h"
+#include "system_timer.h"
+
+/** @defgroup ͳض
+  * @{
+  */
+#ifndef PROFILER_ENABLE
+#define PROFILER_ENABLE          1       // 0: ׮ͳƱȫΪ
+#endif
+#define PROFILER_HIST_BINS       16      // ֱͼnΪ[2^n, 2^(n+1))
+
+/** @}
+  */
+
+/* ׮ͳƱ˱ž̬䣩 */
+typedef enum {
+    PROF_SCALE_TICK = 0,        // ӳ״̬
+    PROF_DISPLAY,               // UpdateWeightDisplay
+    PROF_OVERWEIGHT_CHECK,      // OverweightCheck_RealTime
+    PROF_ADC_WAIT,              // ADCתæȴ
+    PROF_FILTER,                // ˲
+    PROF_REGION_MAX
+} Prof_Region;
+
+/** @brief ͳƣΪHCLKڣֱΪSysTickƵϵ */
+typedef struct {
+    uint32_t Count;                          // ִд
+    uint32_t MinCycles;                      // 
+    uint32_t MaxCycles;                      // 
+    uint64_t TotalCycles;                    // ۼƣƽ
+    uint16_t Histogram[PROFILER_HIST_BINS];  // log2ֱͼͼ
+} Prof_StatsTypeDef;
+
+#if PROFILER_ENABLE
+
+/* ׮꣺ɶʹãֻѭе */
+#define PROF_BEGIN(region)    uint32_t prof_start_##region = GetSystemTimeCycles()
+#define PROF_END(region)      Profiler_Record((region), GetSystemTimeCycles() - prof_start_##region)
+
+void Profiler_Init(void);
+void Profiler_Record(Prof_Region region, uint32_t cycles);
+const Prof_StatsTypeDef* Profiler_GetStats(Prof_Region region);
+void Profiler_Reset(void);
+void Profiler_Dump(void);
+
+#else
+
+#define PROF_BEGIN(region)
+#define PROF_END(region)
+
+#define Profiler_Init()
+#define Profiler_Reset()
+#define Profiler_Dump()
+
+#endif /* PROFILER_ENABLE */
+
+#endif /* __PROFILER_H */
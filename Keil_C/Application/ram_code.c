@@ -0,0 +1,24 @@
+//ram_code.c
+
+#include "ram_code.h"
+
+#if defined(__CC_ARM) || (defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))
+extern uint32_t Image$$RW_RAMCODE$$Length;        // elec_scale.sct
+#elif defined(__GNUC__) && defined(__arm__)
+extern uint32_t __ramfunc_start__;                // Project/elec_scale_gcc.ld
+extern uint32_t __ramfunc_end__;
+#endif
+
+/**
+  * @brief  ȡSRAMռãֽڣϸɵ.mapļ
+  */
+uint32_t RamCode_GetSize(void)
+{
+#if defined(__CC_ARM) || (defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))
+    return (uint32_t)&Image$$RW_RAMCODE$$Length;
+#elif defined(__GNUC__) && defined(__arm__)
+    return (uint32_t)&__ramfunc_end__ - (uint32_t)&__ramfunc_start__;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,46 @@
+//ram_code.h
+
+#ifndef __RAM_CODE_H
+#define __RAM_CODE_H
+
+#include "sc32f1xxx.h"
+
+/*
+ * SRAMִеȵ㺯װʱADCж·¼Ͷݣ
+ *
+ * ƵFlashȡָҪȴڣŵSRAMִпԱܿ
+ * 뵽.ramfuncΣ
+ *   KeilProject/elec_scale.sct.ramfuncRW_RAMCODEִ
+ *         __mainɢʱFlashƵSRAM޸ļ
+ *   GCC Project/elec_scale_gcc.ld.dataοͷ *(.ramfunc*)__ramfunc_start__/__ramfunc_end__
+ *         븴.dataʱһƣ
+ *   루ARMĿ꣩ʱΪգճӡ
+ * SRAMFlashеĺ̼⣩ԻFlashȡָȵ·Ӧ԰
+ * FlashеĴSRAMҪתɴ룬ܶʱʡĵȴڻᱻ
+ */
+#if defined(__CC_ARM) || (defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))
+  #define RAM_FUNC    __attribute__((section(".ramfunc"), noinline))
+#elif defined(__GNUC__) && defined(__arm__)
+  #define RAM_FUNC    __attribute__((section(".ramfunc"), noinline, long_call))
+#else
+  #define RAM_FUNC
+#endif
+
+/*
+ * λݵı.noinitΣʱ㣩
+ *   Keilelec_scale.sctеRW_NOINITִUNINITԣ
+ *   GCC elec_scale_gcc.ld .noinit (NOLOAD) Σ
+ * ϵʱʹħֺУжǷЧ
+ */
+#if defined(__CC_ARM) || (defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))
+  #define RAM_NOINIT  __attribute__((section(".noinit"), zero_init))
+#elif defined(__GNUC__) && defined(__arm__)
+  #define RAM_NOINIT  __attribute__((section(".noinit")))
+#else
+  #define RAM_NOINIT
+#endif
+
+/* SRAMռãֽڣ */
+uint32_t RamCode_GetSize(void);
+
+#endif /* __RAM_CODE_H */
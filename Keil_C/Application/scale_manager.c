@@ -4,64 +4,260 @@
 #include "system_timer.h"
 #include "weight_sensor.h"
 #include "buzzer.h"
+#include "batch_controller.h"
+#include "overload_trip.h"
+#include "soft_timer.h"
+#include "event_queue.h"
+#include "power_manager.h"
+#include "profiler.h"
+#include "supervisor.h"
+#include "seg_lcd.h"
+#include "led_seg.h"
+#include "oled.h"
+#include "debug_console.h"
 #include <math.h>
 
 extern const float OVERWEIGHT_LIMIT;
+extern const float OVERWEIGHT_HYSTERESIS;
+extern const uint32_t OVERWEIGHT_DWELL_TIME;
+extern const uint8_t OVERWEIGHT_LATCH;
 extern const uint32_t OVERWEIGHT_CHECK_FREQ;
 extern const float ACTIVITY_THRESHOLD;
 extern const uint32_t INACTIVITY_TIMEOUT;
+extern const uint32_t STABLE_TIME;
+extern const int32_t DISPLAY_ZERO_BAND;
+extern const uint8_t DISPLAY_DIVISION_STEP;
+extern const uint8_t DISPLAY_HYSTERESIS;
+extern const uint8_t LED_BRIGHTNESS_ACTIVE;
+extern const uint8_t LED_BRIGHTNESS_STANDBY;
+extern const float BATCH_TARGET_WEIGHT;
 
 /* ȫ״̬ */
 ScaleState_t Scale_State = {0};
+static int8_t Scale_Heartbeat = -1;     // Ź໤
+
+/* ʾߵУ׼װ */
+static const Buzzer_ToneTypeDef DoneTones[] = {
+    { 4000, 50, 60, 40 },
+    { 3000, 50, 60,  0 },
+};
+static const Buzzer_PatternTypeDef DonePattern = {
+    DoneTones, 2, 1, BUZZER_PRIORITY_NOTIFY
+};
+
+/**
+  * @brief  ʾͻأʱĩλֵ֮ʾ
+  * @param  milligram: (mg)
+  * @retval 1: Ҫʾ
+  */
+static uint8_t Scale_DisplayChanged(int32_t milligram)
+{
+    int32_t shown = Scale_State.displayedWeight;
+    uint32_t division = DISPLAY_DIVISION_STEP * ((shown > -10000000 && shown < 10000000) ? 100U : 1000U);
+    uint32_t diff = (milligram > shown) ? (uint32_t)milligram - (uint32_t)shown
+                                        : (uint32_t)shown - (uint32_t)milligram;
+    
+    /* ״̬лȶȥƤѵȣǸһ */
+    if(Scale_State.displayRefresh) return 1;
+    return (diff > division || diff * 100U > division * DISPLAY_HYSTERESIS);
+}
 
 /**
   * @brief  ʾ
+  * @param  weight: βõ(g)
   */
-void UpdateWeightDisplay(void)
+void UpdateWeightDisplay(float weight)
 {
-    if(Scale_State.isMeasuring) {
-        Scale_State.currentWeight = WeightSensor_GetWeightGram();
+    int32_t milligram;
+    
+    PROF_BEGIN(PROF_DISPLAY);
+    Scale_State.currentWeight = weight;
+    
+    /* תΪmg󽻸ʽʾ·㣨2000kgⰴ̴ */
+    if(weight > 2000000.0f) {
+        milligram = INT32_MAX;
+    } else if(weight < -2000000.0f) {
+        milligram = INT32_MIN;
     } else {
-        Scale_State.currentWeight = 0.0f;
+        milligram = (int32_t)(weight * 1000.0f + ((weight < 0.0f) ? -0.5f : 0.5f));
+    }
+    
+    if(!Scale_DisplayChanged(milligram)) {
+        PROF_END(PROF_DISPLAY);
+        return;
     }
+    Scale_State.displayedWeight = milligram;
+    Scale_State.displayRefresh = 0;
+    
+    /* ƵӰԴ棬ֻд仯ʾRAMֽ */
+#if DISPLAY_TYPE == DISPLAY_LED_SEG
+    LedSeg_ShowWeight(milligram, DISPLAY_DIVISION_STEP);
+    LedSeg_SetIndicator(LEDSEG_IND_STABLE, Scale_State.mode == SCALE_STABLE);
+    LedSeg_SetIndicator(LEDSEG_IND_ZERO, milligram > -DISPLAY_ZERO_BAND && milligram < DISPLAY_ZERO_BAND);
+    LedSeg_SetIndicator(LEDSEG_IND_TARE, WeightSensor_IsTared());
+    LedSeg_SetIndicator(LEDSEG_IND_OVERLOAD, Scale_State.mode == SCALE_OVERLOADED);
+    LedSeg_SetBlink(Scale_State.mode == SCALE_OVERLOADED ? LEDSEG_BLINK_ALL : 0);
+    LedSeg_Flush();
+#elif DISPLAY_TYPE == DISPLAY_GRAPHIC
+    Oled_ShowWeight(milligram, DISPLAY_DIVISION_STEP);
+    Oled_SetIcon(OLED_ICON_STABLE, Scale_State.mode == SCALE_STABLE);
+    Oled_SetIcon(OLED_ICON_ZERO, milligram > -DISPLAY_ZERO_BAND && milligram < DISPLAY_ZERO_BAND);
+    Oled_SetIcon(OLED_ICON_TARE, WeightSensor_IsTared());
+    Oled_SetIcon(OLED_ICON_OVERLOAD, Scale_State.mode == SCALE_OVERLOADED);
+    Oled_Flush();
+#else
+    SegLcd_ShowWeight(milligram, DISPLAY_DIVISION_STEP);
+    SegLcd_SetIcon(SEGLCD_ICON_STABLE, Scale_State.mode == SCALE_STABLE);
+    SegLcd_SetIcon(SEGLCD_ICON_ZERO, milligram > -DISPLAY_ZERO_BAND && milligram < DISPLAY_ZERO_BAND);
+    SegLcd_SetIcon(SEGLCD_ICON_TARE, WeightSensor_IsTared());
+    SegLcd_SetIcon(SEGLCD_ICON_OVERLOAD, Scale_State.mode == SCALE_OVERLOADED);
+    SegLcd_Flush();
+#endif
+    PROF_END(PROF_DISPLAY);
 }
 
 /**
-  * @brief  ؾ
+  * @brief  ؾֻOverload_SetStateڽ뱨ʱã
   */
-void TriggerOverweightAlarm(void)
+static void TriggerOverweightAlarm(void)
 {
+    BatchController_Abort();  // ʱرռϷ
     Buzzer_Start();  // 
 }
 
 /**
-  * @brief  ֹͣ
+  * @brief  ֹֻͣOverload_SetState˳ʱã
   */
-void StopAlarm(void)
+static void StopAlarm(void)
 {
     Buzzer_Stop();   // ֹͣ
 }
 
 /**
-  * @brief  ʵʱسؼ
+  * @brief  Ƿڼ״̬У
+  */
+static uint8_t Overload_IsActive(OverloadState state)
+{
+    return (state == OVERLOAD_ALARM || state == OVERLOAD_RELEASING || state == OVERLOAD_LATCHED);
+}
+
+/**
+  * @brief  ״̬лֻн/˳ʱŲ
   */
-void OverweightCheck_RealTime(void)
+static void Overload_SetState(OverloadState newState)
 {
-    uint32_t currentTime = GetSystemTime();
+    uint8_t wasActive = Overload_IsActive(Scale_State.overloadState);
+    uint8_t isActive = Overload_IsActive(newState);
     
-    // ÿ500msһ
-    if(currentTime - Scale_State.lastOverweightCheck >= OVERWEIGHT_CHECK_FREQ) {
-        if(Scale_State.overweightMode == OVERWEIGHT_REAL_TIME && 
-           Scale_State.isMeasuring) {
-            float weight = WeightSensor_GetWeightGram();
+    Scale_State.overloadState = newState;
+    Scale_State.overloadStateTime = Time_NowMs();
+    
+    if(!wasActive && isActive) {
+        TriggerOverweightAlarm();
+        Scale_PostEvent(SCALE_EVT_OVERLOAD);
+    } else if(wasActive && !isActive) {
+        StopAlarm();
+        OverloadTrip_Rearm();  // ²Ӳ
+        Scale_PostEvent(SCALE_EVT_OVERLOAD_CLEAR);
+    }
+}
+
+/**
+  * @brief  ״̬/˫ֵ + Сפʱ + ѡ
+  * @param  weight: ǰ(g)
+  */
+static void Overload_Evaluate(float weight)
+{
+    float releaseLimit = OVERWEIGHT_LIMIT - OVERWEIGHT_HYSTERESIS;
+    uint32_t dwell = Time_ElapsedMs(Scale_State.overloadStateTime);
+    
+    switch(Scale_State.overloadState) {
+        case OVERLOAD_NORMAL:
             if(weight > OVERWEIGHT_LIMIT) {
-                TriggerOverweightAlarm();
-            } else {
-                StopAlarm();  // ָֹͣ
+                // ӲѴֱȷϣȽפ
+                Overload_SetState(OverloadTrip_IsTripped() ? OVERLOAD_ALARM : OVERLOAD_PENDING);
+            } else if(OverloadTrip_IsTripped()) {
+                OverloadTrip_Rearm();  // Ӳ󴥷δȷϣ²
+            }
+            break;
+        case OVERLOAD_PENDING:
+            if(weight <= OVERWEIGHT_LIMIT) {
+                Overload_SetState(OVERLOAD_NORMAL);
+            } else if(dwell >= OVERWEIGHT_DWELL_TIME || OverloadTrip_IsTripped()) {
+                Overload_SetState(OVERLOAD_ALARM);
             }
+            break;
+        case OVERLOAD_ALARM:
+            if(weight < releaseLimit) {
+                Overload_SetState(OVERLOAD_RELEASING);
+            }
+            break;
+        case OVERLOAD_RELEASING:
+            if(weight >= releaseLimit) {
+                Overload_SetState(OVERLOAD_ALARM);
+            } else if(dwell >= OVERWEIGHT_DWELL_TIME) {
+                Overload_SetState(OVERWEIGHT_LATCH ? OVERLOAD_LATCHED : OVERLOAD_NORMAL);
+            }
+            break;
+        case OVERLOAD_LATCHED:
+            if(weight > OVERWEIGHT_LIMIT) {
+                Overload_SetState(OVERLOAD_ALARM);
+            }
+            break;  // ȴȷ
+        default:
+            break;
+    }
+}
+
+/**
+  * @brief  ȽӲػصCMPжеãֻͶ¼
+  */
+static void OverloadTrip_Tripped(void)
+{
+    EventQueue_Post(EVENT_OVERLOAD_TRIP, 0, 0);
+}
+
+/**
+  * @brief  Ӳ¼ѭģ
+  * @note   ӲΪ״̬룺ȡʱפ
+  *         ֱӽ뱨NORMAL/PENDINGALARM󴥷²
+  *         ֻOverload_SetStateв
+  */
+static void OverloadTrip_EventHandler(const Event_t* event)
+{
+    (void)event;
+    BatchController_Abort();  // Ųȷϣر
+    if(!Overload_IsActive(Scale_State.overloadState)) {
+        Overload_Evaluate(PowerManager_ReadWeightNow());
+    }
+}
+
+/**
+  * @brief  У׼ĳ趨ȽֵʼȥƤã
+  */
+void OverloadProtection_Update(void)
+{
+    OverloadTrip_SetCallback(OverloadTrip_Tripped);
+    OverloadTrip_SetThresholdCount(WeightSensor_GramToCount(OVERWEIGHT_LIMIT));
+}
+
+/**
+  * @brief  ʵʱسؼ
+  * @param  weight: βõ(g)
+  */
+void OverweightCheck_RealTime(float weight)
+{
+    PROF_BEGIN(PROF_OVERWEIGHT_CHECK);
+    // ÿ500msһ
+    if(Interval_IsDue(&Scale_State.overweightCheck)) {
+        // Ӳش򱨾δʱۼģʽζ
+        if(OverloadTrip_IsTripped() ||
+           Scale_State.overloadState != OVERLOAD_NORMAL ||
+           Scale_State.overweightMode == OVERWEIGHT_REAL_TIME) {
+            Overload_Evaluate(weight);
         }
-        Scale_State.lastOverweightCheck = currentTime;
     }
+    PROF_END(PROF_OVERWEIGHT_CHECK);
 }
 
 /**
@@ -69,42 +265,482 @@ void OverweightCheck_RealTime(void)
   */
 uint8_t OverweightCheck_OnKeyPress(void)
 {
-    float weight = WeightSensor_GetWeightGram();
+    float weight = PowerManager_ReadWeightNow();
     if(weight > OVERWEIGHT_LIMIT) {
-        TriggerOverweightAlarm();
+        Overload_SetState(OVERLOAD_ALARM);
         return 1;  // أ
     }
-    StopAlarm();  // ȷֹͣ
+    if(Scale_State.overloadState != OVERLOAD_LATCHED) {
+        Overload_SetState(OVERLOAD_NORMAL);  // ȷֹͣ
+    }
     return 0;     // 
 }
 
 /**
-  * @brief  仯
+  * @brief  ȷĳر
+  * @retval 1: ȷϣģ  0: 汨
   */
-void CheckWeightActivity(void)
+uint8_t OverweightAlarm_Acknowledge(void)
 {
-    static float lastStableWeight = 0.0f;
-    float currentWeight = WeightSensor_GetWeightGram();
+    if(Scale_State.overloadState != OVERLOAD_LATCHED) return 0;
     
+    Overload_SetState(OVERLOAD_NORMAL);
+    return 1;
+}
+
+/**
+  * @brief  λ״ֹ̬ͣʱã
+  */
+void OverweightAlarm_Reset(void)
+{
+    Overload_SetState(OVERLOAD_NORMAL);
+}
+
+/**
+  * @brief  仯
+  * @param  weight: βõ(g)
+  * @retval 1: 仯ֵ  0: ޱ仯
+  */
+uint8_t CheckWeightActivity(float weight)
+{
     // 仯5gΪû
-    if(fabs(currentWeight - lastStableWeight) > ACTIVITY_THRESHOLD) {
+    if(fabs(weight - Scale_State.lastActivityWeight) > ACTIVITY_THRESHOLD) {
         ResetInactivityTimer();
-        lastStableWeight = currentWeight;
+        Scale_State.lastActivityWeight = weight;
+        return 1;
     }
+    return 0;
+}
+
+/**
+  * @brief  60޲ʱڣʱ¼
+  */
+static void Scale_InactivityExpired(void)
+{
+    Scale_PostEvent(SCALE_EVT_INACTIVITY_TIMEOUT);
+}
+
+/**
+  * @brief  Ƿڲ״̬
+  */
+uint8_t Scale_IsMeasuring(void)
+{
+    return (Scale_State.mode == SCALE_MEASURING || Scale_State.mode == SCALE_SETTLING ||
+            Scale_State.mode == SCALE_STABLE || Scale_State.mode == SCALE_OVERLOADED ||
+            Scale_State.mode == SCALE_BATCHING);
 }
 
 /**
-  * @brief  60޲
+  * @brief  Ļ״̬лʾʱҺϨܽȣػʱرʾ
   */
-void CheckInactivityTimeout(void)
+static void Scale_UpdateScreen(ScaleMode prevMode)
 {
-    uint32_t currentTime = GetSystemTime();
-    uint32_t inactiveTime = currentTime - Scale_State.lastActivityTime;
+    ScaleMode mode = Scale_State.mode;
     
-    if(inactiveTime > INACTIVITY_TIMEOUT) {
-        Scale_State.screenState = SCREEN_STANDBY;  // 
+#if DISPLAY_TYPE == DISPLAY_LED_SEG
+    if(mode == SCALE_OFF) {
+        LedSeg_Clear();
+        LedSeg_Flush();
+        LedSeg_Cmd(DISABLE);
+        return;
+    }
+    if(prevMode == SCALE_OFF) LedSeg_Cmd(ENABLE);
+    
+    /* ʾȱ仯ʱֻĺ */
+    if(Scale_State.screenState == SCREEN_STANDBY) {
+        LedSeg_Clear();
+        LedSeg_ShowDashes();
+        LedSeg_Flush();
+        LedSeg_SetBrightness(LED_BRIGHTNESS_STANDBY);
     } else {
-        Scale_State.screenState = SCREEN_ACTIVE;   // ֻԾ
+        LedSeg_SetBrightness(LED_BRIGHTNESS_ACTIVE);
+    }
+#elif DISPLAY_TYPE == DISPLAY_GRAPHIC
+    /* ˢͣʾԴݱ */
+    if(Scale_State.screenState == SCREEN_STANDBY) {
+        Oled_Clear();
+        Oled_Flush();
+    }
+    if(mode == SCALE_OFF) {
+        Oled_Cmd(DISABLE);
+    } else if(prevMode == SCALE_OFF) {
+        Oled_Cmd(ENABLE);
+    }
+#else
+    if(Scale_State.screenState == SCREEN_STANDBY) {
+        SegLcd_Clear();
+        SegLcd_Flush();
+    }
+    if(mode == SCALE_OFF) {
+        SegLcd_Cmd(DISABLE);
+    } else if(prevMode == SCALE_OFF) {
+        SegLcd_Cmd(ENABLE);
+    }
+#endif
+}
+
+/**
+  * @brief  µĹ״ֻ̬״̬лʱִһεĶ
+  */
+static void Scale_EnterMode(ScaleMode mode)
+{
+    ScaleMode prevMode = Scale_State.mode;
+    
+    /* 뿪װرշţģǰ˻صǰλͻλϵ磩 */
+    if(prevMode == SCALE_BATCHING && mode != SCALE_BATCHING) {
+        BatchController_Abort();
+        PowerManager_SetProfile(PowerManager_GetProfile());
+    }
+    
+    /* /ػʱرģǰ˲STOP뿪ʱָ */
+    if(mode == SCALE_OFF || mode == SCALE_STANDBY) {
+        PowerManager_EnterStandby();
+    } else if(prevMode == SCALE_OFF || prevMode == SCALE_STANDBY) {
+        PowerManager_ExitStandby();
+    }
+    
+    Scale_State.mode = mode;
+    Scale_State.modeEnterTime = Time_NowMs();
+    Scale_State.screenState = (mode == SCALE_OFF || mode == SCALE_STANDBY) ? SCREEN_STANDBY : SCREEN_ACTIVE;
+    Scale_State.displayRefresh = 1;
+    Scale_UpdateScreen(prevMode);
+    
+    switch(mode) {
+        case SCALE_OFF:
+            Scale_State.currentWeight = 0.0f;
+            break;
+        case SCALE_IDLE:
+            Scale_State.currentWeight = 0.0f;
+            // ʱ¼״̬ʱѱԣɴ״̬ʱ¼ʱ
+            if(IsInactivityTimeout()) ResetInactivityTimer();
+            break;
+        case SCALE_MEASURING:
+            ResetInactivityTimer();
+            break;
+        case SCALE_STABLE:
+            if(IsInactivityTimeout()) ResetInactivityTimer();
+            break;
+        case SCALE_CALIBRATING:
+            WeightSensor_CalibrateZeroBegin();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+  * @brief  bʼװǰΪĿ"250b"ʱϴĿ
+  */
+static void Scale_BatchCommand(void)
+{
+    uint32_t target;
+    
+    if(DebugConsole_GetArg(&target) && target > 0) {
+        Scale_State.batchTarget = (float)target;
+    }
+    Scale_PostEvent(SCALE_EVT_BATCH_START);
+}
+
+/**
+  * @brief  xֹװ
+  */
+static void Scale_BatchStopCommand(void)
+{
+    Scale_PostEvent(SCALE_EVT_BATCH_STOP);
+}
+
+/**
+  * @brief  ״̬ʼ
+  */
+void Scale_Init(void)
+{
+    Scale_State.overweightMode = OVERWEIGHT_REAL_TIME;
+    Scale_State.overloadState = OVERLOAD_NORMAL;
+    Scale_State.resumeMode = SCALE_IDLE;
+    Scale_State.batchTarget = BATCH_TARGET_WEIGHT;
+    Interval_Start(&Scale_State.overweightCheck, OVERWEIGHT_CHECK_FREQ);
+    SystemTimer_SetInactivityCallback(Scale_InactivityExpired);
+    EventQueue_Subscribe(EVENT_OVERLOAD_TRIP, OverloadTrip_EventHandler);
+    Scale_EnterMode(SCALE_IDLE);
+    Scale_Heartbeat = Supervisor_Register("scale", 200);
+    DebugConsole_AddCommand('b', Scale_BatchCommand, "batch start [g]");
+    DebugConsole_AddCommand('x', Scale_BatchStopCommand, "batch abort");
+}
+
+/**
+  * @brief  ģʽµĳ
+  * @retval 1: أܾ
+  */
+static uint8_t Scale_KeyOverweightBlocked(void)
+{
+    if(Scale_State.overweightMode == OVERWEIGHT_KEY_CHECK && OverweightCheck_OnKeyPress()) {
+        Buzzer_Beep(20);  // ̴ʾز
+        return 1;
+    }
+    return 0;
+}
+
+/**
+  * @brief  ǰĿ꿪ʼװδװ޷ʱܾ
+  */
+static void Scale_StartBatch(void)
+{
+    if(Scale_KeyOverweightBlocked()) return;
+    if(Scale_State.overloadState != OVERLOAD_NORMAL ||
+       !BatchController_Start(Scale_State.batchTarget)) {
+        Buzzer_Beep(20);
+        return;
+    }
+    Buzzer_Beep(100);
+    Scale_EnterMode(SCALE_BATCHING);
+}
+
+/**
+  * @brief  ״̬µİ
+  */
+static void Scale_HandleMeasureKeys(ScaleEvent event)
+{
+    switch(event) {
+        case SCALE_EVT_KEY_TARE:
+            if(Scale_State.mode == SCALE_OVERLOADED) {
+                Buzzer_Beep(20);  // زȥƤ
+                break;
+            }
+            if(Scale_KeyOverweightBlocked()) break;
+            WeightSensor_Tare();  // ȥƤ
+            OverloadProtection_Update();  // ȥƤ趨Ӳֵ
+            Buzzer_Beep(50);
+            Scale_EnterMode(SCALE_SETTLING);
+            break;
+        case SCALE_EVT_KEY_MEASURE:
+            if(Scale_KeyOverweightBlocked()) break;
+            Buzzer_Beep(30);   // ʾֹͣ
+            Scale_EnterMode(SCALE_IDLE);
+            OverweightAlarm_Reset();  // ֹͣʱҲֹͣ
+            break;
+        case SCALE_EVT_KEY_CALIB:
+        case SCALE_EVT_KEY_CALIB_CHORD:
+            Buzzer_Beep(20);   // вУ׼
+            break;
+        case SCALE_EVT_KEY_BATCH_CHORD:
+        case SCALE_EVT_BATCH_START:
+            Scale_StartBatch();
+            break;
+        case SCALE_EVT_KEY_POWER:
+            Buzzer_Beep(80);
+            Scale_EnterMode(SCALE_OFF);
+            OverweightAlarm_Reset();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+  * @brief  Ͷ¼ǰ״ִ̬ת
+  */
+void Scale_PostEvent(ScaleEvent event)
+{
+    switch(Scale_State.mode) {
+        case SCALE_OFF:
+            if(event == SCALE_EVT_KEY_POWER) {
+                Buzzer_Beep(80);
+                Scale_EnterMode(SCALE_IDLE);
+            }
+            break;
+            
+        case SCALE_IDLE:
+            switch(event) {
+                case SCALE_EVT_KEY_MEASURE:
+                    if(Scale_KeyOverweightBlocked()) break;
+                    Buzzer_Beep(100);  // ʾʼ
+                    Scale_State.lastActivityWeight = 0.0f;
+                    Scale_EnterMode(SCALE_MEASURING);
+                    break;
+                case SCALE_EVT_KEY_TARE:
+                    Buzzer_Beep(20);  // ̴ʾδ
+                    break;
+                case SCALE_EVT_KEY_CALIB:
+                    Buzzer_Beep(20);  // У׼ҪȥƤ+У׼ϼֹ
+                    break;
+                case SCALE_EVT_KEY_CALIB_CHORD:
+                    Buzzer_Beep(100);
+                    Scale_EnterMode(SCALE_CALIBRATING);
+                    break;
+                case SCALE_EVT_KEY_BATCH_CHORD:
+                case SCALE_EVT_BATCH_START:
+                    Scale_StartBatch();
+                    break;
+                case SCALE_EVT_KEY_POWER:
+                    Buzzer_Beep(80);
+                    Scale_EnterMode(SCALE_OFF);
+                    break;
+                case SCALE_EVT_INACTIVITY_TIMEOUT:
+                    Scale_State.resumeMode = SCALE_IDLE;
+                    Scale_EnterMode(SCALE_STANDBY);
+                    break;
+                default:
+                    break;
+            }
+            break;
+            
+        case SCALE_MEASURING:
+        case SCALE_SETTLING:
+        case SCALE_STABLE:
+            switch(event) {
+                case SCALE_EVT_WEIGHT_CHANGED:
+                    if(Scale_State.mode != SCALE_MEASURING) Scale_EnterMode(SCALE_MEASURING);
+                    break;
+                case SCALE_EVT_WEIGHT_STEADY:
+                    if(Scale_State.mode == SCALE_MEASURING) Scale_EnterMode(SCALE_SETTLING);
+                    break;
+                case SCALE_EVT_WEIGHT_STABLE:
+                    if(Scale_State.mode == SCALE_SETTLING) Scale_EnterMode(SCALE_STABLE);
+                    break;
+                case SCALE_EVT_OVERLOAD:
+                    Scale_EnterMode(SCALE_OVERLOADED);
+                    break;
+                case SCALE_EVT_INACTIVITY_TIMEOUT:
+                    if(Scale_State.mode == SCALE_STABLE) {
+                        Scale_State.resumeMode = SCALE_SETTLING;
+                        Scale_EnterMode(SCALE_STANDBY);
+                    }
+                    break;
+                default:
+                    Scale_HandleMeasureKeys(event);
+                    break;
+            }
+            break;
+            
+        case SCALE_OVERLOADED:
+            if(event == SCALE_EVT_OVERLOAD_CLEAR) {
+                Scale_EnterMode(SCALE_SETTLING);
+            } else {
+                Scale_HandleMeasureKeys(event);
+            }
+            break;
+            
+        case SCALE_STANDBY:
+            // ⰴѣָǰ״̬
+            switch(event) {
+                case SCALE_EVT_KEY_TARE:
+                case SCALE_EVT_KEY_CALIB:
+                case SCALE_EVT_KEY_CALIB_CHORD:
+                case SCALE_EVT_KEY_BATCH_CHORD:
+                case SCALE_EVT_KEY_MEASURE:
+                case SCALE_EVT_KEY_POWER:
+                    Scale_EnterMode(Scale_State.resumeMode);
+                    ResetInactivityTimer();
+                    break;
+                default:
+                    break;
+            }
+            break;
+            
+        case SCALE_CALIBRATING:
+            if(event == SCALE_EVT_CALIB_DONE) {
+                Buzzer_Play(&DonePattern);
+                Scale_EnterMode(SCALE_IDLE);
+            }
+            break;
+            
+        case SCALE_BATCHING:
+            switch(event) {
+                case SCALE_EVT_BATCH_DONE:
+                    Buzzer_Play(&DonePattern);
+                    Scale_EnterMode(SCALE_SETTLING);  // ʾ
+                    break;
+                case SCALE_EVT_KEY_MEASURE:
+                case SCALE_EVT_BATCH_STOP:
+                    Buzzer_Beep(30);
+                    Scale_EnterMode(SCALE_SETTLING);  // 뿪װ״̬ʱرշ
+                    break;
+                case SCALE_EVT_OVERLOAD:
+                    Scale_EnterMode(SCALE_OVERLOADED);
+                    break;
+                case SCALE_EVT_KEY_POWER:
+                    Buzzer_Beep(80);
+                    Scale_EnterMode(SCALE_OFF);
+                    break;
+                case SCALE_EVT_KEY_TARE:
+                case SCALE_EVT_KEY_CALIB:
+                case SCALE_EVT_KEY_CALIB_CHORD:
+                case SCALE_EVT_KEY_BATCH_CHORD:
+                case SCALE_EVT_BATCH_START:
+                    Buzzer_Beep(20);  // װвȥƤУ׼ظ
+                    break;
+                default:
+                    break;
+            }
+            break;
+            
+        default:
+            break;
     }
 }
 
+/**
+  * @brief  ״̬ڴִֻеǰ״̬ҪĹ
+  */
+void Scale_Tick(void)
+{
+    float weight;
+    PROF_BEGIN(PROF_SCALE_TICK);
+    Supervisor_CheckIn(Scale_Heartbeat);
+    
+    switch(Scale_State.mode) {
+        case SCALE_IDLE:
+            // ʱӲشʱŶȡȷ
+            if((OverloadTrip_IsTripped() || Scale_State.overloadState != OVERLOAD_NORMAL) &&
+               PowerManager_ReadWeight(&weight)) {
+                OverweightCheck_RealTime(weight);
+            }
+            break;
+            
+        case SCALE_MEASURING:
+        case SCALE_SETTLING:
+        case SCALE_STABLE:
+        case SCALE_OVERLOADED:
+            // ÿֻһΣʾغͻ⹲ã
+            // ͹ĵλͻδʱڲ
+            if(!PowerManager_ReadWeight(&weight)) break;
+            UpdateWeightDisplay(weight);
+            OverweightCheck_RealTime(weight);
+            if(Scale_State.mode == SCALE_OVERLOADED) break;
+            
+            if(CheckWeightActivity(weight)) {
+                Scale_PostEvent(SCALE_EVT_WEIGHT_CHANGED);
+            } else if(Scale_State.mode == SCALE_MEASURING) {
+                Scale_PostEvent(SCALE_EVT_WEIGHT_STEADY);
+            } else if(Scale_State.mode == SCALE_SETTLING &&
+                      Time_ElapsedMs(Scale_State.modeEnterTime) >= STABLE_TIME) {
+                Scale_PostEvent(SCALE_EVT_WEIGHT_STABLE);
+            }
+            break;
+            
+        case SCALE_BATCHING:
+            // ADCתֹжڲжɣֻȡ²ˢʾͳؼ
+            weight = WeightSensor_GetWeightGram();
+            UpdateWeightDisplay(weight);
+            OverweightCheck_RealTime(weight);
+            if(BatchController_GetState() == BATCH_DONE ||
+               BatchController_GetState() == BATCH_ABORTED) {
+                Scale_PostEvent(SCALE_EVT_BATCH_DONE);
+            }
+            break;
+            
+        case SCALE_CALIBRATING:
+            // ճУ׼ÿڲɼһ
+            if(WeightSensor_CalibrateZeroStep(WEIGHT_CALIB_STEP_SAMPLES)) {
+                OverloadProtection_Update();
+                Scale_PostEvent(SCALE_EVT_CALIB_DONE);
+            }
+            break;
+            
+        case SCALE_OFF:
+        case SCALE_STANDBY:
+        default:
+            break;
+    }
+    PROF_END(PROF_SCALE_TICK);
+}
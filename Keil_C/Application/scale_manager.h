@@ -4,6 +4,16 @@
 #define __SCALE_MANAGER_H
 
 #include "sc32f1xxx.h"
+#include "system_timer.h"
+
+/* ʾͣʾģ飬ֻѡһ֣ */
+#define DISPLAY_SEG_LCD          0       // Һ
+#define DISPLAY_LED_SEG          1       // LED
+#define DISPLAY_GRAPHIC          2       // SPIͼOLED
+
+#ifndef DISPLAY_TYPE
+#define DISPLAY_TYPE             DISPLAY_SEG_LCD
+#endif
 
 /* ؼģʽ */
 typedef enum {
@@ -11,6 +21,48 @@ typedef enum {
     OVERWEIGHT_KEY_CHECK        // ʱ
 } OverweightMode;
 
+/* ر״̬ */
+typedef enum {
+    OVERLOAD_NORMAL = 0,  // 
+    OVERLOAD_PENDING,     // ֵȴפʱȷ
+    OVERLOAD_ALARM,       // ر
+    OVERLOAD_RELEASING,   // ڽֵȴפʱȷ
+    OVERLOAD_LATCHED      // ѻָȴȷ
+} OverloadState;
+
+/* ӳӹ״̬ */
+typedef enum {
+    SCALE_OFF = 0,        // ػػ
+    SCALE_IDLE,           // Уδ
+    SCALE_MEASURING,      // У仯
+    SCALE_SETTLING,       // 仯ֹͣȴȶ
+    SCALE_STABLE,         // ȶ
+    SCALE_OVERLOADED,     // ر
+    SCALE_STANDBY,        // ޲
+    SCALE_CALIBRATING,    // У׼
+    SCALE_BATCHING        // װ
+} ScaleMode;
+
+/* ӳ¼ */
+typedef enum {
+    SCALE_EVT_KEY_TARE = 0,       // ȥƤ
+    SCALE_EVT_KEY_CALIB,          // У׼²У׼
+    SCALE_EVT_KEY_CALIB_CHORD,    // ȥƤ+У׼ϼ
+    SCALE_EVT_KEY_BATCH_CHORD,    // ȥƤ+ϼǰĿ꿪ʼװ
+    SCALE_EVT_KEY_MEASURE,        // /ֹͣ
+    SCALE_EVT_KEY_POWER,          // Դ
+    SCALE_EVT_WEIGHT_CHANGED,     // 仯ֵ
+    SCALE_EVT_WEIGHT_STEADY,      // 仯ֹͣ
+    SCALE_EVT_WEIGHT_STABLE,      // ȶ
+    SCALE_EVT_OVERLOAD,           // ر
+    SCALE_EVT_OVERLOAD_CLEAR,     // ر
+    SCALE_EVT_INACTIVITY_TIMEOUT, // ޲ʱ
+    SCALE_EVT_CALIB_DONE,         // У׼
+    SCALE_EVT_BATCH_START,        // ʼװ
+    SCALE_EVT_BATCH_STOP,         // ֹװ
+    SCALE_EVT_BATCH_DONE          // װɻֹ
+} ScaleEvent;
+
 /* Ļ״̬ */
 typedef enum {
     SCREEN_ACTIVE = 0,    // ʾϢ
@@ -19,28 +71,41 @@ typedef enum {
 
 /* ӳ״̬ṹ */
 typedef struct {
-    uint8_t isMeasuring;          // ״̬־
+    ScaleMode mode;               // ǰ״̬
+    ScaleMode resumeMode;         // Ѻָ״̬
+    Time_Ms modeEnterTime;        // 뵱ǰ״̬ʱ
     float currentWeight;          // ǰ
-    ScreenState screenState;      // Ļ״̬
+    int32_t displayedWeight;      // ǰʾ(mgȡǰ)
+    uint8_t displayRefresh;       // ´ʾͻжϣ״̬лλ
+    float lastActivityWeight;     // ϴλʱ
+    ScreenState screenState;      // Ļ״̬湤״̬л£
     OverweightMode overweightMode;// ؼģʽ
-    uint32_t lastActivityTime;    // ʱ
-    uint32_t lastOverweightCheck; // ؼʱ
+    Interval_Ms overweightCheck;  // ؼ
+    OverloadState overloadState;  // ر״̬
+    Time_Ms overloadStateTime;    // 뵱ǰ״̬ʱ
+    float batchTarget;            // װĿ꾻(g)
 } ScaleState_t;
 
 /* ȫ״̬ */
 extern ScaleState_t Scale_State;
 
+/* ״̬ */
+void Scale_Init(void);
+void Scale_PostEvent(ScaleEvent event);
+void Scale_Tick(void);
+uint8_t Scale_IsMeasuring(void);
+
 /*  */
-void UpdateWeightDisplay(void);
+void UpdateWeightDisplay(float weight);
 
 /* ؼغ */
-void TriggerOverweightAlarm(void);
-void StopAlarm(void);
-void OverweightCheck_RealTime(void);
+void OverweightCheck_RealTime(float weight);
+void OverloadProtection_Update(void);
 uint8_t OverweightCheck_OnKeyPress(void);
+uint8_t OverweightAlarm_Acknowledge(void);
+void OverweightAlarm_Reset(void);
 
 /* ޲麯 */
-void CheckWeightActivity(void);
-void CheckInactivityTimeout(void);
+uint8_t CheckWeightActivity(float weight);
 
 #endif /* __SCALE_MANAGER_H */
@@ -0,0 +1,247 @@
+//soft_timer.c
+
+#include "soft_timer.h"
+#include "event_queue.h"
+#include "mem_monitor.h"
+
+#define SOFT_TIMER_WHEEL_MASK    (SOFT_TIMER_WHEEL_SIZE - 1)
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static SoftTimer_t* TimerWheel[SOFT_TIMER_WHEEL_SIZE];   // ʱλɢеĲ
+static Time_Ms WheelTime;                                 // Ѵʱ
+static volatile uint8_t TimerDue = 0;                     // жʱڣжλ¼ʱ
+static volatile uint8_t TimerPosted = 0;                  // ¼Ͷδ
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  ѶʱҵʱӦĲۣ֤߱ѽٽ
+  */
+static void SoftTimer_Link(SoftTimer_t* timer)
+{
+    SoftTimer_t** slot = &TimerWheel[timer->expiry.value & SOFT_TIMER_WHEEL_MASK];
+
+    timer->prev = 0;
+    timer->next = *slot;
+    if(*slot != 0) {
+        (*slot)->prev = timer;
+    }
+    *slot = timer;
+    timer->active = 1;
+}
+
+/**
+  * @brief  Ӳժʱ֤߱ѽٽ
+  */
+static void SoftTimer_Unlink(SoftTimer_t* timer)
+{
+    if(timer->prev != 0) {
+        timer->prev->next = timer->next;
+    } else {
+        TimerWheel[timer->expiry.value & SOFT_TIMER_WHEEL_MASK] = timer->next;
+    }
+    if(timer->next != 0) {
+        timer->next->prev = timer->prev;
+    }
+    timer->next = 0;
+    timer->prev = 0;
+    timer->active = 0;
+}
+
+/**
+  * @brief  ȡһnow֮ǰڵĶʱ
+  * @retval ڵĶʱժû򷵻0
+  */
+static SoftTimer_t* SoftTimer_PopExpired(uint32_t slotIndex, Time_Ms now)
+{
+    SoftTimer_t* timer;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    for(timer = TimerWheel[slotIndex]; timer != 0; timer = timer->next) {
+        if(!Time_IsBefore(now, timer->expiry)) {
+            SoftTimer_Unlink(timer);
+            break;
+        }
+    }
+    __set_PRIMASK(primask);
+    return timer;
+}
+
+/**
+  * @brief  ¼־ƽʱ
+  */
+static void SoftTimer_EventHandler(const Event_t* event)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    (void)event;
+    /* ־ڼµڵĶʱͶһ¼ */
+    __disable_irq();
+    TimerDue = 0;
+    TimerPosted = 0;
+    __set_PRIMASK(primask);
+    SoftTimer_Process();
+}
+
+/**
+  * @brief  ִһȫڵĶʱ
+  */
+static void SoftTimer_ExpireSlot(uint32_t slotIndex, Time_Ms now)
+{
+    SoftTimer_t* timer;
+
+    /* ÿֻȡһص/ֹͣʱҲƻ */
+    while((timer = SoftTimer_PopExpired(slotIndex, now)) != 0) {
+        if(timer->periodMs != 0) {
+            /* ڶʱۼӣ̫ʱӵǰʱ¶ */
+            uint32_t primask = __get_PRIMASK();
+            timer->expiry = Time_AddMs(timer->expiry, timer->periodMs);
+            if(!Time_IsBefore(now, timer->expiry)) {
+                timer->expiry = Time_AddMs(now, timer->periodMs);
+            }
+            __disable_irq();
+            SoftTimer_Link(timer);
+            __set_PRIMASK(primask);
+        }
+        if(timer->callback != 0) {
+            timer->callback(timer->arg);
+        }
+    }
+}
+
+/**
+  * @brief  ʱʼ
+  */
+void SoftTimer_Init(void)
+{
+    for(uint32_t i = 0; i < SOFT_TIMER_WHEEL_SIZE; i++) {
+        TimerWheel[i] = 0;
+    }
+    WheelTime = Time_NowMs();
+    TimerDue = 0;
+    TimerPosted = 0;
+    MemMonitor_AddModule("soft_timer", sizeof(TimerWheel));
+    EventQueue_Subscribe(EVENT_TIMER_DUE, SoftTimer_EventHandler);
+}
+
+/**
+  * @brief  ʼʱǰһΣ
+  */
+void SoftTimer_Create(SoftTimer_t* timer, SoftTimer_Callback callback, void* arg)
+{
+    timer->next = 0;
+    timer->prev = 0;
+    timer->periodMs = 0;
+    timer->callback = callback;
+    timer->arg = arg;
+    timer->active = 0;
+}
+
+/**
+  * @brief  ʱĶʱ¼ʱ
+  * @param  delayMs: ״εʱ(ms)
+  * @param  periodMs: ֮(ms)0ʾζʱ
+  */
+void SoftTimer_Start(SoftTimer_t* timer, uint32_t delayMs, uint32_t periodMs)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    /* ʱ1ms֤ڲۻδʱɨ */
+    if(delayMs == 0) delayMs = 1;
+
+    __disable_irq();
+    if(timer->active) {
+        SoftTimer_Unlink(timer);
+    }
+    timer->periodMs = periodMs;
+    timer->expiry = Time_AddMs(Time_NowMs(), delayMs);
+    SoftTimer_Link(timer);
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  ֹͣʱ
+  */
+void SoftTimer_Stop(SoftTimer_t* timer)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if(timer->active) {
+        SoftTimer_Unlink(timer);
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  ʱǷ
+  */
+uint8_t SoftTimer_IsActive(const SoftTimer_t* timer)
+{
+    return timer->active;
+}
+
+/**
+  * @brief  ƽʱִ֣ȫڵĻصѭеã
+  */
+void SoftTimer_Process(void)
+{
+    Time_Ms now = Time_NowMs();
+    uint32_t lag = now.value - WheelTime.value;
+
+    if(lag == 0) return;
+
+    if(lag >= SOFT_TIMER_WHEEL_SIZE) {
+        /* 󳬹һȦÿۼһμɸеڶʱ */
+        for(uint32_t i = 0; i < SOFT_TIMER_WHEEL_SIZE; i++) {
+            SoftTimer_ExpireSlot(i, now);
+        }
+    } else {
+        /* ƽֻʶӦĲ */
+        while(WheelTime.value != now.value) {
+            WheelTime = Time_AddMs(WheelTime, 1);
+            SoftTimer_ExpireSlot(WheelTime.value & SOFT_TIMER_WHEEL_MASK, now);
+        }
+    }
+    WheelTime = now;
+}
+
+/**
+  * @brief  ʱһSTOPģʽƽʱ
+  * @note   Ĳжϲ飬һSysTickжͶݵ¼
+  */
+void SoftTimer_Kick(void)
+{
+    TimerDue = 1;
+}
+
+/**
+  * @brief  鵱ǰӦĲۣжʱʱͶ¼SysTickжеã
+  * @note   ʱڱ־һͶ
+  */
+void SoftTimer_SysTickHandler(void)
+{
+    uint32_t now;
+    SoftTimer_t* timer;
+
+    if(TimerPosted) return;
+
+    if(!TimerDue) {
+        now = GetSystemTimeMs();
+        for(timer = TimerWheel[now & SOFT_TIMER_WHEEL_MASK]; timer != 0; timer = timer->next) {
+            if((int32_t)(now - timer->expiry.value) >= 0) {
+                TimerDue = 1;
+                break;
+            }
+        }
+    }
+
+    if(TimerDue && EventQueue_Post(EVENT_TIMER_DUE, 0, 0)) {
+        TimerPosted = 1;
+    }
+}
@@ -0,0 +1,51 @@
+//soft_timer.h
+
+#ifndef __SOFT_TIMER_H
+#define __SOFT_TIMER_H
+
+#include "sc32f1xxx.h"
+#include "system_timer.h"
+
+/** @defgroup ʱض
+  * @{
+  */
+#define SOFT_TIMER_WHEEL_SIZE    32      // ʱֲ2ݣÿ1ms
+
+/** @}
+  */
+
+/*
+ * ʱֲ1msƽSysTickжֻ鵱ǰӦĲۣ
+ * еڶʱʱͶEVENT_TIMER_DUEѭַ¼ʱƽʱֲִлص
+ * ûжʱʱѭᱻѡ
+ */
+
+/** @brief ʱصѭеã԰ȫҵ״̬ */
+typedef void (*SoftTimer_Callback)(void* arg);
+
+/** @brief ʱɵ߾̬䣬ʱֵĲϣ */
+typedef struct SoftTimer {
+    struct SoftTimer* next;        // 
+    struct SoftTimer* prev;
+    Time_Ms expiry;                // ʱ
+    uint32_t periodMs;             // (ms)0ʾ
+    SoftTimer_Callback callback;   // ڻص
+    void* arg;                     // ص
+    uint8_t active;                // Ƿ
+} SoftTimer_t;
+
+/* ʼͿƺ */
+void SoftTimer_Init(void);
+void SoftTimer_Create(SoftTimer_t* timer, SoftTimer_Callback callback, void* arg);
+void SoftTimer_Start(SoftTimer_t* timer, uint32_t delayMs, uint32_t periodMs);
+void SoftTimer_Stop(SoftTimer_t* timer);
+uint8_t SoftTimer_IsActive(const SoftTimer_t* timer);
+
+/* ʱƽEVENT_TIMER_DUEеã */
+void SoftTimer_Process(void);
+void SoftTimer_Kick(void);
+
+/* ڼ飨SysTickжеã */
+void SoftTimer_SysTickHandler(void);
+
+#endif /* __SOFT_TIMER_H */
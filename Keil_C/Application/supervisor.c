@@ -0,0 +1,311 @@
+//supervisor.c
+
+#include "supervisor.h"
+#include "sc32f1xxx_rcc.h"
+#include "system_timer.h"
+#include "ram_code.h"
+#include "debug_uart.h"
+#include "debug_console.h"
+
+#define SUPERVISOR_SYSTICK_CHECK_MS   16     // SysTickмļ
+
+/** @brief Ǽ */
+typedef struct {
+    const char* Name;
+    uint32_t DeadlineMs;         // δ򿨵
+    Time_Ms LastCheckIn;         // һδʱ
+    uint8_t Enabled;             // 0: ͣ飨ֻĳڼҪ
+} Supervisor_HeartbeatTypeDef;
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static Supervisor_HeartbeatTypeDef Heartbeats[SUPERVISOR_MAX_TASKS];
+static uint8_t HeartbeatCount = 0;
+static WDT_OverTime_TypeDef Supervisor_Timeout = WDT_OverTime_500MS;
+static uint8_t Supervisor_Started = 0;
+static volatile uint8_t Supervisor_Active = 0;      // ŹҼ
+static volatile uint8_t Supervisor_Tripped = 0;     // жʱֹͣιȴλ
+static uint8_t SysTickDivider = 0;
+static Supervisor_FaultTypeDef LastFault;           // ʱȡϴι
+static uint8_t HasLastFault = 0;
+
+/* λ벻㣬ħֺУжǷЧ */
+static RAM_NOINIT Supervisor_FaultTypeDef Supervisor_Record;
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  ϼ¼У֣У֮ǰȡ
+  */
+static uint32_t Supervisor_RecordCheck(const Supervisor_FaultTypeDef* record)
+{
+    const uint32_t* word = (const uint32_t*)record;
+    uint32_t check = 0;
+
+    for(uint32_t i = 0; i < sizeof(Supervisor_FaultTypeDef) / sizeof(uint32_t) - 1; i++) {
+        check ^= word[i];
+    }
+    return ~check;
+}
+
+/**
+  * @brief  У
+  */
+static void Supervisor_RecordSeal(void)
+{
+    Supervisor_Record.Check = Supervisor_RecordCheck(&Supervisor_Record);
+}
+
+/**
+  * @brief  ¼ʱʹѺã
+  */
+static void Supervisor_RefreshAll(void)
+{
+    Time_Ms now = Time_NowMs();
+
+    for(uint8_t i = 0; i < HeartbeatCount; i++) {
+        Heartbeats[i].LastCheckIn = now;
+    }
+}
+
+/**
+  * @brief  ҳʱ
+  * @retval һʱţȫʱ-1
+  */
+static int8_t Supervisor_FindOverdue(void)
+{
+    for(uint8_t i = 0; i < HeartbeatCount; i++) {
+        if(Heartbeats[i].Enabled &&
+           Time_ElapsedMs(Heartbeats[i].LastCheckIn) > Heartbeats[i].DeadlineMs) {
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+  * @brief  жʱдϼ¼ֹͣιֻ¼һΣ
+  */
+static void Supervisor_Trip(int8_t id)
+{
+    uint32_t primask = __get_PRIMASK();
+    const char* name = Heartbeats[id].Name;
+    uint8_t i;
+
+    __disable_irq();
+    if(!Supervisor_Tripped) {
+        Supervisor_Record.Magic = SUPERVISOR_RECORD_MAGIC;
+        Supervisor_Record.ResetCount++;
+        Supervisor_Record.UptimeMs = GetSystemTimeMs();
+        Supervisor_Record.MissedTask = id;
+        Supervisor_Record.RunningTask = Scheduler_GetRunningTask();
+        Supervisor_Record.Pending = 1;
+        for(i = 0; i < SUPERVISOR_NAME_LEN - 1 && name[i] != '\0'; i++) {
+            Supervisor_Record.Name[i] = name[i];
+        }
+        for(; i < SUPERVISOR_NAME_LEN; i++) {
+            Supervisor_Record.Name[i] = '\0';
+        }
+        Supervisor_RecordSeal();
+        Supervisor_Tripped = 1;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Ź໤ʼУ鱣¼ϴεļ໤λעᴮ w
+  */
+void Supervisor_Init(Supervisor_InitTypeDef* Supervisor_InitStruct)
+{
+    Supervisor_Timeout = Supervisor_InitStruct->Timeout;
+
+    if(Supervisor_Record.Magic != SUPERVISOR_RECORD_MAGIC ||
+       Supervisor_Record.Check != Supervisor_RecordCheck(&Supervisor_Record)) {
+        /* ϵ¼𻵣½ */
+        Supervisor_Record.Magic = SUPERVISOR_RECORD_MAGIC;
+        Supervisor_Record.ResetCount = 0;
+        Supervisor_Record.UptimeMs = 0;
+        Supervisor_Record.MissedTask = -1;
+        Supervisor_Record.RunningTask = -1;
+        Supervisor_Record.Pending = 0;
+        Supervisor_Record.Reserved = 0;
+        for(uint8_t i = 0; i < SUPERVISOR_NAME_LEN; i++) {
+            Supervisor_Record.Name[i] = '\0';
+        }
+        Supervisor_RecordSeal();
+    } else if(Supervisor_Record.Pending) {
+        /* ϴɼ໤ֹͣι¸λ */
+        LastFault = Supervisor_Record;
+        HasLastFault = 1;
+        Supervisor_Record.Pending = 0;
+        Supervisor_RecordSeal();
+        Supervisor_Dump();
+    }
+
+    DebugConsole_AddCommand('w', Supervisor_Dump, "watchdog report");
+}
+
+/**
+  * @brief  ӲŹȫǼ֮ã
+  */
+void Supervisor_Start(void)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_IFB, ENABLE);   // ŹʹλѡĴ
+    WDT_SetOverTime(Supervisor_Timeout);
+    Supervisor_RefreshAll();
+    WDT_SetReload();
+    WDT_Cmd(ENABLE);
+
+    Supervisor_Started = 1;
+    Supervisor_Active = 1;
+}
+
+/**
+  * @brief  ǼǼǺʼʱ
+  * @param  name: ƣַ
+  * @param  deadlineMs: δ򿨵ӦΪڵ
+  * @retval ţǼǱʱ-1
+  */
+int8_t Supervisor_Register(const char* name, uint32_t deadlineMs)
+{
+    if(HeartbeatCount >= SUPERVISOR_MAX_TASKS) return -1;
+
+    Heartbeats[HeartbeatCount].Name = name;
+    Heartbeats[HeartbeatCount].DeadlineMs = deadlineMs;
+    Heartbeats[HeartbeatCount].LastCheckIn = Time_NowMs();
+    Heartbeats[HeartbeatCount].Enabled = 1;
+    return (int8_t)HeartbeatCount++;
+}
+
+/**
+  * @brief  ʹ/ͣ飬ʹʱ¼ʱ
+  * @param  id: Supervisor_Registerص
+  * @param  NewState: ENABLE/DISABLE
+  */
+void Supervisor_HeartbeatCmd(int8_t id, FunctionalState NewState)
+{
+    if(id < 0 || id >= HeartbeatCount) return;
+
+    Heartbeats[id].LastCheckIn = Time_NowMs();
+    Heartbeats[id].Enabled = (NewState != DISABLE);
+}
+
+/**
+  * @brief  
+  */
+void Supervisor_CheckIn(int8_t id)
+{
+    if(id < 0 || id >= HeartbeatCount) return;
+
+    Heartbeats[id].LastCheckIn = Time_NowMs();
+}
+
+/**
+  * @brief  ڴѭģȫδʱι¼Ϻȴλ
+  */
+void Supervisor_Process(void)
+{
+    int8_t id;
+
+    if(!Supervisor_Active) return;
+
+    id = Supervisor_FindOverdue();
+    if(id >= 0) {
+        Supervisor_Trip(id);
+    }
+    if(!Supervisor_Tripped) {
+        WDT_SetReload();
+    }
+}
+
+/**
+  * @brief  SysTickжеãѭĳʱ໤񲻻Уڴ˼¼
+  */
+void Supervisor_SysTickHandler(void)
+{
+    int8_t id;
+
+    if(!Supervisor_Active || Supervisor_Tripped) return;
+    if(++SysTickDivider < SUPERVISOR_SYSTICK_CHECK_MS) return;
+    SysTickDivider = 0;
+
+    id = Supervisor_FindOverdue();
+    if(id >= 0) {
+        Supervisor_Trip(id);
+    }
+}
+
+/**
+  * @brief  ͣ໤ʱã
+  */
+void Supervisor_Suspend(void)
+{
+    if(!Supervisor_Started) return;
+
+    Supervisor_Active = 0;
+    WDT_Cmd(DISABLE);
+}
+
+/**
+  * @brief  ָ໤˳ʱãȫ¼ʱ
+  */
+void Supervisor_Resume(void)
+{
+    if(!Supervisor_Started) return;
+
+    Supervisor_RefreshAll();
+    WDT_SetReload();
+    WDT_Cmd(ENABLE);
+    Supervisor_Active = 1;
+}
+
+/**
+  * @brief  ȡʱȡϴιϼ¼
+  * @retval ޼¼ʱ0
+  */
+const Supervisor_FaultTypeDef* Supervisor_GetLastFault(void)
+{
+    return HasLastFault ? &LastFault : 0;
+}
+
+/**
+  * @brief  ͨԴ໤棺λϴιϡϴδ򿨵ʱ
+  */
+void Supervisor_Dump(void)
+{
+    DebugUart_WriteString("wdt resets ");
+    DebugUart_WriteUint(Supervisor_Record.ResetCount);
+    DebugUart_WriteNewLine();
+
+    if(HasLastFault) {
+        DebugUart_WriteString(" last missed ");
+        DebugUart_WriteString(LastFault.Name);
+        DebugUart_WriteString(" running ");
+        if(LastFault.RunningTask < 0) {
+            DebugUart_WriteChar('-');
+        } else {
+            DebugUart_WriteUint((uint32_t)LastFault.RunningTask);
+        }
+        DebugUart_WriteString(" uptime ");
+        DebugUart_WriteUint(LastFault.UptimeMs);
+        DebugUart_WriteNewLine();
+    }
+
+    for(uint8_t i = 0; i < HeartbeatCount; i++) {
+        DebugUart_WriteChar(' ');
+        DebugUart_WriteString(Heartbeats[i].Name);
+        DebugUart_WriteChar(' ');
+        if(!Heartbeats[i].Enabled) {
+            DebugUart_WriteString("off");
+            DebugUart_WriteNewLine();
+            continue;
+        }
+        DebugUart_WriteUint(Time_ElapsedMs(Heartbeats[i].LastCheckIn));
+        DebugUart_WriteChar('/');
+        DebugUart_WriteUint(Heartbeats[i].DeadlineMs);
+        DebugUart_WriteNewLine();
+    }
+}
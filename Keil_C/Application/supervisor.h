@@ -0,0 +1,60 @@
+//supervisor.h
+
+#ifndef __SUPERVISOR_H
+#define __SUPERVISOR_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_wdt.h"
+
+/** @defgroup Ź໤ض
+  * @{
+  */
+#define SUPERVISOR_MAX_TASKS     8               // Ǽ
+#define SUPERVISOR_NAME_LEN      12              // ϼ¼бƳȣ
+#define SUPERVISOR_RECORD_MAGIC  0x57444F47U     // 'WDOG'
+
+/** @}
+  */
+
+/** @brief Ź໤ýṹ */
+typedef struct {
+    WDT_OverTime_TypeDef Timeout;    // ӲŹʱӦڼ໤ڵ2
+} Supervisor_InitTypeDef;
+
+/** @brief ϼ¼λڸλRAM´οʱ棩 */
+typedef struct {
+    uint32_t Magic;                  // SUPERVISOR_RECORD_MAGIC
+    uint32_t ResetCount;             // ۼƵļ໤λ
+    uint32_t UptimeMs;               // жʱʱʱ
+    int8_t MissedTask;               // ʱ
+    int8_t RunningTask;              // ʱִеĵţ-1ʾ
+    uint8_t Pending;                 // 1: Ѽ¼δڿʱ
+    uint8_t Reserved;
+    char Name[SUPERVISOR_NAME_LEN];  // ʱ
+    uint32_t Check;                  // У
+} Supervisor_FaultTypeDef;
+
+/* ʼԴڳʼ֮ãϴεļ໤λ */
+void Supervisor_Init(Supervisor_InitTypeDef* Supervisor_InitStruct);
+void Supervisor_Start(void);
+
+/* ǼǺʹ򿨣ģԼڴд򿨣 */
+int8_t Supervisor_Register(const char* name, uint32_t deadlineMs);
+void Supervisor_CheckIn(int8_t id);
+void Supervisor_HeartbeatCmd(int8_t id, FunctionalState NewState);
+
+/* ڴȫδʱι */
+void Supervisor_Process(void);
+
+/* жϴҪSC_it.cSysTickжеãѭʱ¼ */
+void Supervisor_SysTickHandler(void);
+
+/* ڼͣ໤BTMѼŹʱ */
+void Supervisor_Suspend(void);
+void Supervisor_Resume(void);
+
+/* ѯ */
+const Supervisor_FaultTypeDef* Supervisor_GetLastFault(void);   // ޼¼ʱ0
+void Supervisor_Dump(void);
+
+#endif /* __SUPERVISOR_H */
@@ -1,6 +1,9 @@
 //system_timer.c
 
 #include "system_timer.h"
+#include "soft_timer.h"
+#include "mem_monitor.h"
+#include "sc32f1xxx_pwr.h"
 #include "sc32f1xxx_btm.h"
 
 /** @defgroup ģ˽б
@@ -8,10 +11,45 @@
   */
 SystemTimer_t systemTimer;
 
+/* ޲ʱʱÿβ¼ʱڻصһΣ */
+static SoftTimer_t InactivityTimer;
+static void (*InactivityCallback)(void) = 0;
+
+/* ȱá´ͷʱͳ */
+typedef struct {
+    SchedTask_InitTypeDef Config;
+    Time_Ms NextRelease;                   // ´ͷʱ
+    SchedTask_StatsTypeDef Stats;
+} SchedTask_t;
+
+static SchedTask_t Sched_Tasks[SCHED_MAX_TASKS];
+static uint8_t Sched_TaskCount = 0;
+static volatile int8_t Sched_Running = -1;         // ִеţ-1ʾ
+static Sched_ClockFunction Sched_NowMs = GetSystemTimeMs;
+static Sched_ClockFunction Sched_NowUs = GetSystemTimeUs;
+static SchedTask_Function Sched_IdleHook = 0;
+static uint8_t (*Sched_PendingCheck)(void) = 0;      // жͶݵδĹ
+
+/* ռձͳƣÿڽʱ£ */
+static uint32_t Sched_WindowStartUs = 0;
+static uint32_t Sched_WindowSleepUs = 0;
+static uint16_t Sched_AwakePermille = 1000;
+
 /**
   * @}
   */
 
+/**
+  * @brief  ޲ʱʱ
+  */
+static void SystemTimer_InactivityExpired(void* arg)
+{
+    (void)arg;
+    if(InactivityCallback != 0) {
+        InactivityCallback();
+    }
+}
+
 /**
   * @brief  ϵͳʱʼ
   */
@@ -19,60 +57,255 @@ void SystemTimer_Init(void)
 {
     // ʼ
     systemTimer.msCounter = 0;
-    systemTimer.lastOverweightCheck = 0;
-    systemTimer.lastActivityTime = 0;
-    systemTimer.lastSystemUpdate = 0;
-    systemTimer.loopCounter = 0;
+    systemTimer.msCounterHigh = 0;
+    systemTimer.lastActivityTime.value = 0;
+    MemMonitor_AddModule("scheduler", sizeof(Sched_Tasks));
     
-    // ʼBTMʱ62.5msжϣ
-    BTM_FSConfig(BTM, BTM_FreqSelect_62_5MS);
-    BTM_ITConfig(BTM, BTM_IT_INT, ENABLE);
-    BTM_Cmd(BTM, ENABLE);
+    // SysTickΪ1msʱBTM62.5msĲڼʱ
+    SystemTimer_ConfigSysTick();
+    
+    // ʱʱ
+    SoftTimer_Init();
+    SoftTimer_Create(&InactivityTimer, SystemTimer_InactivityExpired, 0);
     
     // óʼʱ
     ResetInactivityTimer();
 }
 
+/**
+  * @brief  ǰHCLK¼SysTickװֵ֤1msģʱлã
+  */
+void SystemTimer_ConfigSysTick(void)
+{
+    RCC_ClocksTypeDef RCC_Clocks;
+    uint32_t sysTickClock;
+    
+    RCC_GetClocksFreq(&RCC_Clocks);
+    sysTickClock = RCC_Clocks.HCLK_Frequency / SYSTICK_CLOCK_DIV;
+    
+    systemTimer.ticksPerUs = sysTickClock / 1000000;
+    if(systemTimer.ticksPerUs == 0) systemTimer.ticksPerUs = 1;
+    
+    RCC_SystickSetCounter(sysTickClock / SYSTICK_RATE_HZ);
+}
+
+/**
+  * @brief  ȡһµĺ͵ǰѼֵ
+  * @param  sub: رѾSysTick
+  * @retval 64λ
+  */
+static uint64_t SystemTimer_Snapshot(uint32_t* sub)
+{
+    uint32_t high, low, val, load;
+    
+    /* ߡ͡˳ȡȡڼ䷢жϣλʱλҲ䣩ض */
+    do {
+        high = systemTimer.msCounterHigh;
+        low = systemTimer.msCounter;
+        val = SysTick->VAL;
+    } while(low != systemTimer.msCounter || high != systemTimer.msCounterHigh);
+    
+    load = SysTick->LOAD;
+    
+    /* жϱʱѻƵδۼ */
+    if((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && val > (load >> 1)) {
+        if(++low == 0) high++;
+    }
+    
+    *sub = load - val;
+    return ((uint64_t)high << 32) | low;
+}
+
 uint32_t GetSystemTimeMs(void)
 {
     return systemTimer.msCounter;
 }
 
-uint32_t GetSystemTime(void)
+/**
+  * @brief  64λ
+  */
+uint64_t GetSystemTimeMs64(void)
 {
-    return systemTimer.loopCounter;
+    uint32_t sub;
+    return SystemTimer_Snapshot(&sub);
 }
 
-uint32_t SystemTimer_GetElapsedMs(uint32_t startTime)
+/**
+  * @brief  ΢ʱ32λԼ71ӻƣֵ㲻Ӱ죩
+  */
+uint32_t GetSystemTimeUs(void)
+{
+    uint32_t sub;
+    uint32_t ms = (uint32_t)SystemTimer_Snapshot(&sub);
+    return ms * 1000 + sub / systemTimer.ticksPerUs;
+}
+
+/**
+  * @brief  64λ΢ʱ
+  */
+uint64_t GetSystemTimeUs64(void)
 {
-    uint32_t currentTime = GetSystemTimeMs();
+    uint32_t sub;
+    uint64_t ms = SystemTimer_Snapshot(&sub);
+    return ms * 1000 + sub / systemTimer.ticksPerUs;
+}
+
+/**
+  * @brief  HCLKʱ32λƣֵ㲻Ӱ죩ֱΪSysTickƵϵ
+  * @note   ͳƣʱӵλлĲֵ
+  */
+uint32_t GetSystemTimeCycles(void)
+{
+    uint32_t sub;
+    uint32_t ms = (uint32_t)SystemTimer_Snapshot(&sub);
+    return (ms * (SysTick->LOAD + 1) + sub) * SYSTICK_CLOCK_DIV;
+}
+
+/**
+  * @brief  SysTickֹͣڼ䣨STOPģʽʱ
+  * @note   STOPߣͷʱһƣʱ䲻ͷӳٺͽֹʱ
+  */
+void SystemTimer_AdvanceMs(uint32_t ms)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t before;
     
-    if (currentTime >= startTime) {
-        return currentTime - startTime;
-    } else {
-        return (0xFFFFFFFF - startTime) + currentTime + 1;
+    __disable_irq();
+    before = systemTimer.msCounter;
+    systemTimer.msCounter = before + ms;
+    if(systemTimer.msCounter < before) {
+        systemTimer.msCounterHigh++;
+    }
+    __set_PRIMASK(primask);
+    
+    for(uint8_t i = 0; i < Sched_TaskCount; i++) {
+        Sched_Tasks[i].NextRelease = Time_AddMs(Sched_Tasks[i].NextRelease, ms);
     }
+    
+    // ʱֲжϲ
+    SoftTimer_Kick();
+}
+
+/**
+  * @brief  ǰʱ
+  */
+Time_Ms Time_NowMs(void)
+{
+    Time_Ms now = { GetSystemTimeMs() };
+    return now;
+}
+
+/**
+  * @brief  ǰ΢ʱ
+  */
+Time_Us Time_NowUs(void)
+{
+    Time_Us now = { GetSystemTimeUs() };
+    return now;
+}
+
+/**
+  * @brief  ָʱ㾭ĺƺȻȷ
+  */
+uint32_t Time_ElapsedMs(Time_Ms since)
+{
+    return GetSystemTimeMs() - since.value;
+}
+
+/**
+  * @brief  ָʱ㾭΢ƺȻȷ
+  */
+uint32_t Time_ElapsedUs(Time_Us since)
+{
+    return GetSystemTimeUs() - since.value;
+}
+
+/**
+  * @brief  ʱһʱ
+  */
+Time_Ms Time_AddMs(Time_Ms time, uint32_t durationMs)
+{
+    time.value += durationMs;
+    return time;
+}
+
+/**
+  * @brief  ʱaǷb಻2^31msʱЧ
+  */
+uint8_t Time_IsBefore(Time_Ms a, Time_Ms b)
+{
+    return ((int32_t)(a.value - b.value) < 0);
+}
+
+/**
+  * @brief  ӵǰʱ̿ʼʱtimeoutMs
+  */
+void Deadline_Start(Deadline_Ms* deadline, uint32_t timeoutMs)
+{
+    deadline->expiry = Time_AddMs(Time_NowMs(), timeoutMs);
+}
+
+/**
+  * @brief  Ƿѳʱ
+  */
+uint8_t Deadline_IsExpired(const Deadline_Ms* deadline)
+{
+    return !Time_IsBefore(Time_NowMs(), deadline->expiry);
+}
+
+/**
+  * @brief  볬ʱʣѳʱ0
+  */
+uint32_t Deadline_RemainingMs(const Deadline_Ms* deadline)
+{
+    if(Deadline_IsExpired(deadline)) return 0;
+    return deadline->expiry.value - GetSystemTimeMs();
+}
+
+/**
+  * @brief  ڼӵǰʱһں״ε
+  */
+void Interval_Start(Interval_Ms* interval, uint32_t periodMs)
+{
+    interval->periodMs = periodMs;
+    interval->next = Time_AddMs(Time_NowMs(), periodMs);
 }
 
-uint32_t SystemTimer_GetElapsedLoops(uint32_t startCount)
+/**
+  * @brief  ǷڣʱԶһ
+  * @note   ´εʱ䰴ۼӣʱ̵Ķۻ
+  *         󳬹һʱӵǰʱ¶룬
+  */
+uint8_t Interval_IsDue(Interval_Ms* interval)
 {
-    uint32_t currentCount = GetSystemTime();
+    Time_Ms now = Time_NowMs();
     
-    if (currentCount >= startCount) {
-        return currentCount - startCount;
-    } else {
-        return (0xFFFFFFFF - startCount) + currentCount + 1;
+    if(Time_IsBefore(now, interval->next)) return 0;
+    
+    interval->next = Time_AddMs(interval->next, interval->periodMs);
+    if(!Time_IsBefore(now, interval->next)) {
+        interval->next = Time_AddMs(now, interval->periodMs);
     }
+    return 1;
 }
 
 void ResetInactivityTimer(void)
 {
-    systemTimer.lastActivityTime = GetSystemTimeMs();
+    systemTimer.lastActivityTime = Time_NowMs();
+    SoftTimer_Start(&InactivityTimer, INACTIVITY_TIMEOUT_MS, 0);
+}
+
+/**
+  * @brief  ޲ʱصѭеã
+  */
+void SystemTimer_SetInactivityCallback(void (*callback)(void))
+{
+    InactivityCallback = callback;
 }
 
 uint32_t GetInactivityTime(void)
 {
-    return SystemTimer_GetElapsedMs(systemTimer.lastActivityTime);
+    return Time_ElapsedMs(systemTimer.lastActivityTime);
 }
 
 uint8_t IsInactivityTimeout(void)
@@ -80,27 +313,238 @@ uint8_t IsInactivityTimeout(void)
     return (GetInactivityTime() >= INACTIVITY_TIMEOUT_MS);
 }
 
-uint8_t IsOverweightCheckTime(void)
+/**
+  * @brief  SysTick 1msжϴҪSC_it.cеã
+  */
+void SystemTimer_SysTick_IRQHandler(void)
+{
+    if(++systemTimer.msCounter == 0) {
+        systemTimer.msCounterHigh++;
+    }
+}
+
+/**
+  * @brief  񵽵ȱʼ׶εã
+  * @retval ţȱЧʱ-1
+  */
+int8_t Scheduler_AddTask(const SchedTask_InitTypeDef* SchedTask_InitStruct)
+{
+    SchedTask_t* task;
+    
+    if(Sched_TaskCount >= SCHED_MAX_TASKS) return -1;
+    if(SchedTask_InitStruct->Function == 0 || SchedTask_InitStruct->PeriodMs == 0) return -1;
+    
+    task = &Sched_Tasks[Sched_TaskCount];
+    task->Config = *SchedTask_InitStruct;
+    task->NextRelease.value = Sched_NowMs() + task->Config.PhaseMs;
+    task->Stats = (SchedTask_StatsTypeDef){0};
+    
+    return (int8_t)Sched_TaskCount++;
+}
+
+/**
+  * @brief  ԵǰʱΪ¼״ͷʱ
+  */
+void Scheduler_Start(void)
+{
+    uint32_t now = Sched_NowMs();
+    
+    Sched_WindowStartUs = Sched_NowUs();
+    Sched_WindowSleepUs = 0;
+    
+    for(uint8_t i = 0; i < Sched_TaskCount; i++) {
+        Sched_Tasks[i].NextRelease.value = now + Sched_Tasks[i].Config.PhaseMs;
+    }
+}
+
+/**
+  * @brief  ִһ񣨵ȼߡͷһ
+  * @retval 1: ִ  0: ûе
+  */
+uint8_t Scheduler_RunOnce(void)
+{
+    SchedTask_t* task = 0;
+    Time_Ms now = { Sched_NowMs() };
+    uint32_t lateness, missed, start, exec;
+    
+    /* ѡȱȽȼͬȼȡȴõ */
+    for(uint8_t i = 0; i < Sched_TaskCount; i++) {
+        SchedTask_t* t = &Sched_Tasks[i];
+        if(Time_IsBefore(now, t->NextRelease)) continue;
+        if(task == 0 ||
+           t->Config.Priority < task->Config.Priority ||
+           (t->Config.Priority == task->Config.Priority &&
+            Time_IsBefore(t->NextRelease, task->NextRelease))) {
+            task = t;
+        }
+    }
+    if(task == 0) return 0;
+    
+    /* ͷӳٳһڼֹʱ䣬Աλ */
+    lateness = now.value - task->NextRelease.value;
+    if(lateness > task->Stats.MaxLatenessMs) {
+        task->Stats.MaxLatenessMs = lateness;
+    }
+    missed = lateness / task->Config.PeriodMs;
+    task->Stats.DeadlineMisses += missed;
+    task->NextRelease = Time_AddMs(task->NextRelease, (missed + 1) * task->Config.PeriodMs);
+    
+    /* ִвͳִʱ */
+    start = Sched_NowUs();
+    Sched_Running = (int8_t)(task - Sched_Tasks);
+    task->Config.Function();
+    Sched_Running = -1;
+    exec = Sched_NowUs() - start;
+    
+    task->Stats.RunCount++;
+    task->Stats.LastExecUs = exec;
+    if(exec > task->Stats.MaxExecUs) {
+        task->Stats.MaxExecUs = exec;
+    }
+    if(task->Config.BudgetUs != 0 && exec > task->Config.BudgetUs) {
+        task->Stats.BudgetOverruns++;
+    }
+    return 1;
+}
+
+/**
+  * @brief  ȡִеţжеãڶλ
+  * @retval ţʱ-1
+  */
+int8_t Scheduler_GetRunningTask(void)
+{
+    return Sched_Running;
+}
+
+/**
+  * @brief  Ƿѵͷʱ
+  */
+static uint8_t Scheduler_TaskDue(void)
+{
+    Time_Ms now = { Sched_NowMs() };
+    
+    for(uint8_t i = 0; i < Sched_TaskCount; i++) {
+        if(!Time_IsBefore(now, Sched_Tasks[i].NextRelease)) return 1;
+    }
+    return 0;
+}
+
+/**
+  * @brief  ߣжϼǷдûвŽIDLEģʽ
+  * @note   жڼ䵽жϱֹWFIأᶪʧѡ
+  *         ѺжִжϷûͶ¼ҲûڣͨSysTickģ
+  *         ֱٴߣصѭ
+  */
+static void Scheduler_Idle(void)
+{
+    uint32_t start = Sched_NowUs();
+    
+    while(1) {
+        __disable_irq();
+        if((Sched_PendingCheck != 0 && Sched_PendingCheck()) || Scheduler_TaskDue()) {
+            break;
+        }
+        if(Sched_IdleHook != 0) {
+            Sched_IdleHook();
+        } else {
+            PWR_EnterIDLEMode(PWR_IDLEEntry_WFI);  // SysTick//ADC/CMPжϻ
+        }
+        __enable_irq();
+    }
+    Sched_WindowSleepUs += Sched_NowUs() - start;
+    __enable_irq();
+}
+
+/**
+  * @brief  »ռձͳ
+  */
+static void Scheduler_UpdateDutyCycle(void)
+{
+    uint32_t windowUs = Sched_NowUs() - Sched_WindowStartUs;
+    
+    if(windowUs < SCHED_DUTY_WINDOW_MS * 1000UL) return;
+    
+    if(Sched_WindowSleepUs >= windowUs) {
+        Sched_AwakePermille = 0;
+    } else {
+        Sched_AwakePermille = (uint16_t)(1000 - (uint32_t)(((uint64_t)Sched_WindowSleepUs * 1000) / windowUs));
+    }
+    Sched_WindowStartUs += windowUs;
+    Sched_WindowSleepUs = 0;
+}
+
+/**
+  * @brief  ѭִȫʱߵȴж
+  */
+void Scheduler_Run(void)
+{
+    uint8_t ran = 0;
+    
+    while(Scheduler_RunOnce()) {
+        ran = 1;
+    }
+    
+    if(!ran) {
+        Scheduler_Idle();
+    }
+    
+    Scheduler_UpdateDutyCycle();
+}
+
+/**
+  * @brief  ô麯ط0ʱߣ
+  */
+void Scheduler_SetPendingCheck(uint8_t (*pendingCheck)(void))
 {
-    return (SystemTimer_GetElapsedMs(systemTimer.lastOverweightCheck) >= OVERWEIGHT_CHECK_INTERVAL);
+    Sched_PendingCheck = pendingCheck;
 }
 
-void UpdateOverweightCheckTime(void)
+/**
+  * @brief  ȡһͳƴڵĻʱռ
+  * @retval ǧֱȣ0-1000
+  */
+uint16_t Scheduler_GetAwakePermille(void)
 {
-    systemTimer.lastOverweightCheck = GetSystemTimeMs();
+    return Sched_AwakePermille;
 }
 
-uint8_t IsSystemUpdateTime(void)
+/**
+  * @brief  滻ʱӣעģʱӽ֤
+  * @param  msClock: ʱӣΪ0ʱʹϵͳ
+  * @param  usClock: ΢ʱӣִʱͳƣΪ0ʱʹSysTick΢ʱ
+  */
+void Scheduler_SetClock(Sched_ClockFunction msClock, Sched_ClockFunction usClock)
+{
+    Sched_NowMs = (msClock != 0) ? msClock : GetSystemTimeMs;
+    Sched_NowUs = (usClock != 0) ? usClock : GetSystemTimeUs;
+    Sched_WindowStartUs = Sched_NowUs();
+    Sched_WindowSleepUs = 0;
+}
+
+/**
+  * @brief  ÿлص޵ʱڹж״̬µãĬϵIDLEߣ
+  */
+void Scheduler_SetIdleHook(SchedTask_Function idleHook)
 {
-    return (SystemTimer_GetElapsedMs(systemTimer.lastSystemUpdate) >= SYSTEM_UPDATE_INTERVAL);
+    Sched_IdleHook = idleHook;
 }
 
-void UpdateSystemUpdateTime(void)
+/**
+  * @brief  ȡͳ
+  * @retval ͳָ룬Чʱ0
+  */
+const SchedTask_StatsTypeDef* Scheduler_GetStats(uint8_t taskId)
 {
-    systemTimer.lastSystemUpdate = GetSystemTimeMs();
+    if(taskId >= Sched_TaskCount) return 0;
+    return &Sched_Tasks[taskId].Stats;
 }
 
-void SystemTimer_Update(void)
+/**
+  * @brief  ȫͳ
+  */
+void Scheduler_ResetStats(void)
 {
-    systemTimer.loopCounter++;
+    for(uint8_t i = 0; i < Sched_TaskCount; i++) {
+        Sched_Tasks[i].Stats = (SchedTask_StatsTypeDef){0};
+    }
 }
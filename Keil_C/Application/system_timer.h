@@ -9,13 +9,44 @@ extern "C" {
 
 #include "sc32f1xxx.h"
 #include "sc32f1xxx_btm.h"
+#include "sc32f1xxx_rcc.h"
 
 /** @defgroup ϵͳʱض
   * @{
   */
 #define INACTIVITY_TIMEOUT_MS    60000   // ޲ʱʱ60
-#define OVERWEIGHT_CHECK_INTERVAL 1000   // ؼ1
-#define SYSTEM_UPDATE_INTERVAL    100    // ϵͳ״̬¼100ms
+#define SYSTICK_RATE_HZ          1000    // SysTickƵ1kHz1ms
+#define SYSTICK_CLOCK_DIV        8       // SysTickʱ = HCLK/8SC_SYSTICK_Init
+#define SCHED_MAX_TASKS          8       // ȱ̬䣩
+#define SCHED_DUTY_WINDOW_MS     1000    // ռձͳƴ(ms)
+
+/** @}
+  */
+
+/** @defgroup ʱͣͬλʹòͬͣʱ뱨
+  * @{
+  */
+
+/** @brief ʱ㣬32λƣֻͨTime_xxxȽ */
+typedef struct {
+    uint32_t value;
+} Time_Ms;
+
+/** @brief ΢ʱ㣨SysTickʱ32λ */
+typedef struct {
+    uint32_t value;
+} Time_Us;
+
+/** @brief ʱֹʱ */
+typedef struct {
+    Time_Ms expiry;
+} Deadline_Ms;
+
+/** @brief ̶ڼۼӣʱƯƣ */
+typedef struct {
+    Time_Ms next;                          // ´εʱ
+    uint32_t periodMs;                     // (ms)
+} Interval_Ms;
 
 /** @}
   */
@@ -24,13 +55,44 @@ extern "C" {
   * @{
   */
 typedef struct {
-    volatile uint32_t msCounter;           // BTMжϸ£
-    uint32_t lastOverweightCheck;          // ϴγؼʱ
-    uint32_t lastActivityTime;             // ʱ
-    uint32_t lastSystemUpdate;             // ϴϵͳʱ
-    uint32_t loopCounter;                  // ѭԭд룩
+    volatile uint32_t msCounter;           // SysTickжϸ£
+    volatile uint32_t msCounterHigh;       // 32λ
+    uint32_t ticksPerUs;                   // SysTickÿ΢ֵ
+    Time_Ms lastActivityTime;              // ʱ
 } SystemTimer_t;
 
+/** @}
+  */
+
+/** @defgroup Эʽṹ
+  * @{
+  */
+
+/** @brief ִأ */
+typedef void (*SchedTask_Function)(void);
+
+/** @brief ʱӺ滻Ϊģʱ */
+typedef uint32_t (*Sched_ClockFunction)(void);
+
+/** @brief ýṹ */
+typedef struct {
+    SchedTask_Function Function;   // 
+    uint32_t PeriodMs;             // (ms)ֹʱ
+    uint32_t PhaseMs;              // ״Եƫ(ms)ڴ
+    uint8_t Priority;              // ȼֵԽСԽִ
+    uint32_t BudgetUs;             // ִʱԤ(us)0ʾ
+} SchedTask_InitTypeDef;
+
+/** @brief ͳ */
+typedef struct {
+    uint32_t RunCount;             // ִд
+    uint32_t DeadlineMisses;       // ֹʱδִУ
+    uint32_t BudgetOverruns;       // ִʱԤĴ
+    uint32_t LastExecUs;           // ϴִʱ(us)
+    uint32_t MaxExecUs;            // ִʱ(us)
+    uint32_t MaxLatenessMs;        // ͷӳ(ms)
+} SchedTask_StatsTypeDef;
+
 /** @}
   */
 
@@ -40,27 +102,54 @@ typedef struct {
 
 /* ʼ */
 void SystemTimer_Init(void);
-void BTM_Timer_Init(void);
+void SystemTimer_ConfigSysTick(void);
 
 /* ʱȡ */
 uint32_t GetSystemTimeMs(void);
-uint32_t GetSystemTime(void);
-uint32_t SystemTimer_GetElapsedMs(uint32_t startTime);
-uint32_t SystemTimer_GetElapsedLoops(uint32_t startCount);
+uint64_t GetSystemTimeMs64(void);
+uint32_t GetSystemTimeUs(void);
+uint64_t GetSystemTimeUs64(void);
+uint32_t GetSystemTimeCycles(void);
+
+/* ʱ䲹SysTickֹͣڼʱԴۼƣ */
+void SystemTimer_AdvanceMs(uint32_t ms);
+
+/* ͻʱ亯ȫưȫ */
+Time_Ms Time_NowMs(void);
+Time_Us Time_NowUs(void);
+uint32_t Time_ElapsedMs(Time_Ms since);
+uint32_t Time_ElapsedUs(Time_Us since);
+Time_Ms Time_AddMs(Time_Ms time, uint32_t durationMs);
+uint8_t Time_IsBefore(Time_Ms a, Time_Ms b);
+
+/* ʱڼ */
+void Deadline_Start(Deadline_Ms* deadline, uint32_t timeoutMs);
+uint8_t Deadline_IsExpired(const Deadline_Ms* deadline);
+uint32_t Deadline_RemainingMs(const Deadline_Ms* deadline);
+void Interval_Start(Interval_Ms* interval, uint32_t periodMs);
+uint8_t Interval_IsDue(Interval_Ms* interval);
 
 /* ޲⺯ */
 void ResetInactivityTimer(void);
+void SystemTimer_SetInactivityCallback(void (*callback)(void));
 uint32_t GetInactivityTime(void);
 uint8_t IsInactivityTimeout(void);
 
-/* ʱ麯 */
-uint8_t IsOverweightCheckTime(void);
-uint8_t IsSystemUpdateTime(void);
-void UpdateOverweightCheckTime(void);
-void UpdateSystemUpdateTime(void);
-
-/* ѭ */
-void SystemTimer_Update(void);
+/* жϴҪSC_it.cSysTick_IRQHandlerеã */
+void SystemTimer_SysTick_IRQHandler(void);
+
+/* Эʽ */
+int8_t Scheduler_AddTask(const SchedTask_InitTypeDef* SchedTask_InitStruct);
+void Scheduler_Start(void);
+uint8_t Scheduler_RunOnce(void);
+void Scheduler_Run(void);
+void Scheduler_SetClock(Sched_ClockFunction msClock, Sched_ClockFunction usClock);
+void Scheduler_SetIdleHook(SchedTask_Function idleHook);
+void Scheduler_SetPendingCheck(uint8_t (*pendingCheck)(void));
+uint16_t Scheduler_GetAwakePermille(void);
+int8_t Scheduler_GetRunningTask(void);
+const SchedTask_StatsTypeDef* Scheduler_GetStats(uint8_t taskId);
+void Scheduler_ResetStats(void);
 
 /** @}
   */
@@ -2,7 +2,151 @@
 
 #include "buzzer.h"
 
+/** @brief ͶвۣBuzzer_Beepĵڲڣ */
+typedef struct {
+    Buzzer_PatternTypeDef Pattern;
+    Buzzer_ToneTypeDef Tone;
+    uint32_t Seq;                // ˳ͬȼȲ
+    uint8_t Used;
+} Buzzer_SlotTypeDef;
+
 static Buzzer_InitTypeDef Buzzer_Handler;
+static uint32_t Buzzer_ClockHz = 0;        // PWMʱӣPCLK0
+
+/* ״̬SysTickжƽѭ޸ʱжϣ */
+static Buzzer_SlotTypeDef Buzzer_Slots[BUZZER_QUEUE_SIZE];
+static uint32_t Buzzer_Seq = 0;
+static volatile int8_t Buzzer_Current = -1;    // еĲۣ-1Ϊ
+static uint8_t Buzzer_ToneIndex = 0;
+static uint8_t Buzzer_PlayCount = 0;           // Ѳŵı
+static uint8_t Buzzer_Sounding = 0;            // ķ
+static uint16_t Buzzer_Remaining = 0;          // ǰʣms
+
+/* ر4kHz 200msͣ100msѭ */
+static const Buzzer_ToneTypeDef Buzzer_AlarmTones[] = {
+    { 4000, 50, 200, 100 },
+};
+static const Buzzer_PatternTypeDef Buzzer_AlarmPattern = {
+    Buzzer_AlarmTones, 1, BUZZER_REPEAT_FOREVER, BUZZER_PRIORITY_ALARM
+};
+
+/**
+  * @brief  PWMʱںռձ
+  */
+static void Buzzer_ApplyTiming(uint32_t frequency, uint8_t duty_cycle)
+{
+    uint32_t cycle = Buzzer_ClockHz / frequency;
+
+    /* ڼĴ16λʱӹʱضϵֵ */
+    if(cycle > 0xFFFF) cycle = 0xFFFF;
+    if(cycle < 2) cycle = 2;
+
+    PWM_SetCycle(Buzzer_Handler.PWMx, (uint16_t)cycle);
+    PWM_SetDuty(Buzzer_Handler.PWMx, Buzzer_Handler.Channel, (uint16_t)((cycle * duty_cycle) / 100));
+}
+
+/**
+  * @brief  ʼǰķ
+  */
+static void Buzzer_StartTone(void)
+{
+    const Buzzer_ToneTypeDef* tone = &Buzzer_Slots[Buzzer_Current].Pattern.Tones[Buzzer_ToneIndex];
+
+    if(tone->Frequency != 0) {
+        Buzzer_ApplyTiming(tone->Frequency, tone->DutyCycle);
+        PWM_Cmd(Buzzer_Handler.PWMx, ENABLE);
+    } else {
+        PWM_Cmd(Buzzer_Handler.PWMx, DISABLE);
+    }
+    Buzzer_Sounding = 1;
+    Buzzer_Remaining = tone->OnMs ? tone->OnMs : 1;
+}
+
+/**
+  * @brief  ͷָ
+  */
+static void Buzzer_StartSlot(int8_t slot)
+{
+    Buzzer_Current = slot;
+    Buzzer_ToneIndex = 0;
+    Buzzer_PlayCount = 0;
+    Buzzer_StartTone();
+}
+
+/**
+  * @brief  ŵȴȼߡӵͣûرPWM
+  */
+static void Buzzer_StartNext(void)
+{
+    int8_t next = -1;
+
+    for(int8_t i = 0; i < BUZZER_QUEUE_SIZE; i++) {
+        if(!Buzzer_Slots[i].Used) continue;
+        if(next < 0 ||
+           Buzzer_Slots[i].Pattern.Priority > Buzzer_Slots[next].Pattern.Priority ||
+           (Buzzer_Slots[i].Pattern.Priority == Buzzer_Slots[next].Pattern.Priority &&
+            (int32_t)(Buzzer_Slots[i].Seq - Buzzer_Slots[next].Seq) < 0)) {
+            next = i;
+        }
+    }
+
+    if(next >= 0) {
+        Buzzer_StartSlot(next);
+    } else {
+        PWM_Cmd(Buzzer_Handler.PWMx, DISABLE);
+        Buzzer_Current = -1;
+        Buzzer_Sounding = 0;
+    }
+}
+
+/**
+  * @brief  ӣѹжϣ
+  * @retval 1: ӻʼ  0: 
+  */
+static uint8_t Buzzer_Enqueue(const Buzzer_PatternTypeDef* pattern, const Buzzer_ToneTypeDef* tone)
+{
+    Buzzer_SlotTypeDef* slot;
+    int8_t free = -1;
+
+    /* ȼѭ֮ԶֱֲӶ */
+    if(Buzzer_Current >= 0 &&
+       Buzzer_Slots[Buzzer_Current].Pattern.Repeat == BUZZER_REPEAT_FOREVER &&
+       pattern->Priority <= Buzzer_Slots[Buzzer_Current].Pattern.Priority) {
+        return 0;
+    }
+
+    for(int8_t i = 0; i < BUZZER_QUEUE_SIZE; i++) {
+        if(!Buzzer_Slots[i].Used) {
+            free = i;
+            break;
+        }
+    }
+
+    if(free < 0) {
+        /* ֻиڵǰŵͿռǰ */
+        if(pattern->Priority <= Buzzer_Slots[Buzzer_Current].Pattern.Priority) return 0;
+        free = Buzzer_Current;
+    }
+
+    slot = &Buzzer_Slots[free];
+    slot->Pattern = *pattern;
+    if(tone != 0) {
+        slot->Tone = *tone;
+        slot->Pattern.Tones = &slot->Tone;
+        slot->Pattern.ToneCount = 1;
+    }
+    slot->Seq = Buzzer_Seq++;
+    slot->Used = 1;
+
+    if(Buzzer_Current < 0 || free == Buzzer_Current) {
+        Buzzer_StartSlot(free);
+    } else if(pattern->Priority > Buzzer_Slots[Buzzer_Current].Pattern.Priority) {
+        /* ϵȼͣϵĲ */
+        Buzzer_Slots[Buzzer_Current].Used = 0;
+        Buzzer_StartSlot(free);
+    }
+    return 1;
+}
 
 /**
   * @brief  ʼ
@@ -14,100 +158,175 @@ void Buzzer_Init(Buzzer_InitTypeDef* Buzzer_InitStruct)
     Buzzer_Handler.Channel = Buzzer_InitStruct->Channel;
     Buzzer_Handler.Frequency = Buzzer_InitStruct->Frequency;
     Buzzer_Handler.DutyCycle = Buzzer_InitStruct->DutyCycle;
-    
+
     /* PWM */
     PWM_InitTypeDef PWM_InitStructure;
-    
+
     /* PWMṹʼ */
     PWM_StructInit(&PWM_InitStructure);
-    
+
     /* PWM */
     PWM_InitStructure.PWM_Prescaler = PWM_PRESCALER_DIV1;     // ԤƵ
     PWM_InitStructure.PWM_AlignedMode = PWM_AlignmentMode_Edge; // ضģʽ
     PWM_InitStructure.PWM_WorkMode = PWM_WorkMode_Independent;  // ģʽ
-    
-    /* ֵ */
-    // ϵͳʱΪ16MHz = ʱƵ / PWMƵ
-    uint32_t system_clock = 16000000; // Ҫʵϵͳʱӵ
-    PWM_InitStructure.PWM_Cycle = system_clock / Buzzer_Handler.Frequency;
-    
+
+    /*  = PWMʱ / PWMƵʣʱȡԵǰPCLK0 */
+    RCC_ClocksTypeDef RCC_Clocks;
+    RCC_GetClocksFreq(&RCC_Clocks);
+    Buzzer_ClockHz = RCC_Clocks.PCLK0_Frequency;
+    PWM_InitStructure.PWM_Cycle = Buzzer_ClockHz / Buzzer_Handler.Frequency;
+
     /* ͨ */
     PWM_InitStructure.PWM_OutputChannel = Buzzer_Handler.Channel;
     PWM_InitStructure.PWM_LowPolarityChannl = PWMChannel_Less; // 
-    
+
     /* ʼPWM */
     PWM_Init(Buzzer_Handler.PWMx, &PWM_InitStructure);
-    
-    /* ռձ */
-    uint16_t duty_value = (PWM_InitStructure.PWM_Cycle * Buzzer_Handler.DutyCycle) / 100;
-    PWM_SetDuty(Buzzer_Handler.PWMx, Buzzer_Handler.Channel, duty_value);
-    
+
+    /* ںռձ */
+    Buzzer_ApplyTiming(Buzzer_Handler.Frequency, Buzzer_Handler.DutyCycle);
+
     /* ʼ״̬رPWM */
     PWM_Cmd(Buzzer_Handler.PWMx, DISABLE);
 }
 
 /**
-  * @brief  ʱ
+  * @brief  ͣͼΪ̬洢
+  * @retval 1: ѿʼŻŶ  0: ȼ͵ס
+  */
+uint8_t Buzzer_Play(const Buzzer_PatternTypeDef* pattern)
+{
+    uint32_t primask;
+    uint8_t ok;
+
+    if(pattern == 0 || pattern->Tones == 0 || pattern->ToneCount == 0) return 0;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ok = Buzzer_Enqueue(pattern, 0);
+    __set_PRIMASK(primask);
+    return ok;
+}
+
+/**
+  * @brief  ʱУʾȼв죩
   */
 void Buzzer_Beep(uint32_t duration_ms)
 {
-    /* PWM,ʼ */
-    PWM_Cmd(Buzzer_Handler.PWMx, ENABLE);
-    
-    /* ȴָʱ */
-    // Ҫʵʱ
-    // Delay_ms(duration_ms);
-    
-    /* رPWMֹͣ */
-    PWM_Cmd(Buzzer_Handler.PWMx, DISABLE);
+    Buzzer_PatternTypeDef pattern = { 0, 1, 1, BUZZER_PRIORITY_CLICK };
+    Buzzer_ToneTypeDef tone;
+    uint32_t primask;
+
+    tone.Frequency = (uint16_t)Buzzer_Handler.Frequency;
+    tone.DutyCycle = Buzzer_Handler.DutyCycle;
+    tone.OnMs = (duration_ms > 0xFFFF) ? 0xFFFF : (uint16_t)duration_ms;
+    tone.OffMs = 0;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    Buzzer_Enqueue(&pattern, &tone);
+    __set_PRIMASK(primask);
 }
 
 /**
-  * @brief  УҪֶֹͣ
+  * @brief  رѭţҪBuzzer_Stopֹͣ
   */
 void Buzzer_Start(void)
 {
-    /* PWM */
-    PWM_Cmd(Buzzer_Handler.PWMx, ENABLE);
+    if(Buzzer_Current >= 0 && Buzzer_Slots[Buzzer_Current].Pattern.Tones == Buzzer_AlarmTones) return;
+
+    Buzzer_Play(&Buzzer_AlarmPattern);
 }
 
 /**
-  * @brief  ֹͣ
+  * @brief  ֹͣյȴе
   */
 void Buzzer_Stop(void)
 {
-    PWM_Cmd(Buzzer_Handler.PWMx, DISABLE);
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    for(uint8_t i = 0; i < BUZZER_QUEUE_SIZE; i++) {
+        Buzzer_Slots[i].Used = 0;
+    }
+    Buzzer_StartNext();
+    __set_PRIMASK(primask);
 }
 
 /**
-  * @brief  ÷Ƶ
+  * @brief  ǷڲţľΣ
+  */
+uint8_t Buzzer_IsActive(void)
+{
+    return Buzzer_Current >= 0;
+}
+
+/**
+  * @brief  Buzzer_BeepʹõƵ
   */
 void Buzzer_SetFrequency(uint32_t frequency)
 {
+    if(frequency == 0) return;
     Buzzer_Handler.Frequency = frequency;
-    
-    /* ¼㲢 */
-    uint32_t system_clock = 16000000; // Ҫʵϵͳʱӵ
-    uint16_t cycle_value = system_clock / frequency;
-    PWM_SetCycle(Buzzer_Handler.PWMx, cycle_value);
-    
-    /* ռձԱֱ */
-    uint16_t duty_value = (cycle_value * Buzzer_Handler.DutyCycle) / 100;
-    PWM_SetDuty(Buzzer_Handler.PWMx, Buzzer_Handler.Channel, duty_value);
 }
 
 /**
-  * @brief  ռձ
+  * @brief  Buzzer_Beepʹõռձ
   */
 void Buzzer_SetDutyCycle(uint8_t duty_cycle)
 {
     if(duty_cycle > 100) duty_cycle = 100;
     Buzzer_Handler.DutyCycle = duty_cycle;
-    
-    /* ȡǰֵ */
-    uint16_t cycle_value = PWM_GetCycle(Buzzer_Handler.PWMx);
-    
-    /* 㲢µռձֵ */
-    uint16_t duty_value = (cycle_value * duty_cycle) / 100;
-    PWM_SetDuty(Buzzer_Handler.PWMx, Buzzer_Handler.Channel, duty_value);
+}
+
+/**
+  * @brief  ʱлµPCLK0¼PWMڣעᵽʱӹ
+  */
+void Buzzer_ClockChanged(const RCC_ClocksTypeDef* clocks)
+{
+    uint32_t primask = __get_PRIMASK();
+    const Buzzer_ToneTypeDef* tone;
+
+    __disable_irq();
+    Buzzer_ClockHz = clocks->PCLK0_Frequency;
+    if(Buzzer_Current >= 0 && Buzzer_Sounding) {
+        tone = &Buzzer_Slots[Buzzer_Current].Pattern.Tones[Buzzer_ToneIndex];
+        if(tone->Frequency != 0) {
+            Buzzer_ApplyTiming(tone->Frequency, tone->DutyCycle);
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  ƽSysTickжϣÿ1msã ->  -> һ -> һ -> һ
+  */
+void Buzzer_TimerHandler(void)
+{
+    Buzzer_SlotTypeDef* slot;
+    const Buzzer_ToneTypeDef* tone;
+
+    if(Buzzer_Current < 0) return;
+    if(--Buzzer_Remaining != 0) return;
+
+    slot = &Buzzer_Slots[Buzzer_Current];
+    tone = &slot->Pattern.Tones[Buzzer_ToneIndex];
+
+    if(Buzzer_Sounding && tone->OffMs != 0) {
+        PWM_Cmd(Buzzer_Handler.PWMx, DISABLE);
+        Buzzer_Sounding = 0;
+        Buzzer_Remaining = tone->OffMs;
+        return;
+    }
+
+    if(++Buzzer_ToneIndex >= slot->Pattern.ToneCount) {
+        Buzzer_ToneIndex = 0;
+        if(slot->Pattern.Repeat != BUZZER_REPEAT_FOREVER &&
+           ++Buzzer_PlayCount >= (slot->Pattern.Repeat ? slot->Pattern.Repeat : 1)) {
+            slot->Used = 0;
+            Buzzer_StartNext();
+            return;
+        }
+    }
+    Buzzer_StartTone();
 }
@@ -5,6 +5,16 @@
 #include "sc32f1xxx.h"
 #include "sc32f1xxx_gpio.h"
 #include "sc32f1xxx_pwm.h"
+#include "sc32f1xxx_rcc.h"
+
+/** @defgroup ض
+  * @{
+  */
+#define BUZZER_QUEUE_SIZE        4       // к͵ȴе
+#define BUZZER_REPEAT_FOREVER    0xFF    // ѭֱBuzzer_Stop
+
+/** @}
+  */
 
 /** @brief ýṹ */
 typedef struct {
@@ -14,13 +24,38 @@ typedef struct {
     uint8_t DutyCycle;           // ռձȣ0-100
 } Buzzer_InitTypeDef;
 
+/** @brief ȼȼڲŵĵȼ */
+typedef enum {
+    BUZZER_PRIORITY_CLICK = 0,   // ʾ
+    BUZZER_PRIORITY_NOTIFY,      // ״̬ʾУ׼ɵȣ
+    BUZZER_PRIORITY_ALARM        // أ
+} Buzzer_Priority;
+
+/** @brief  */
+typedef struct {
+    uint16_t Frequency;          // ƵʣHz0Ϊ
+    uint8_t DutyCycle;           // ռձȣ0-100
+    uint16_t OnMs;               // ʱ
+    uint16_t OffMs;              // ľʱ
+} Buzzer_ToneTypeDef;
+
+/** @brief ͣ鰴˳򲥷Repeat飩 */
+typedef struct {
+    const Buzzer_ToneTypeDef* Tones;
+    uint8_t ToneCount;
+    uint8_t Repeat;              // űBUZZER_REPEAT_FOREVERΪѭ
+    Buzzer_Priority Priority;
+} Buzzer_PatternTypeDef;
+
 void Buzzer_Init(Buzzer_InitTypeDef* Buzzer_InitStruct);  // ʼ
-void Buzzer_Beep(uint32_t duration_ms);  // ʱ
-void Buzzer_Start(void);  // У
-void Buzzer_Stop(void);  // ֹͣ
-void Buzzer_SetFrequency(uint32_t frequency);  // Ƶ
-void Buzzer_SetDutyCycle(uint8_t duty_cycle);  // ռձ
-void Buzzer_TimerHandler(void);
+uint8_t Buzzer_Play(const Buzzer_PatternTypeDef* pattern);  // ͣ
+void Buzzer_Beep(uint32_t duration_ms);  // ĬƵһʾȼ
+void Buzzer_Start(void);  // رѭҪֶֹͣ
+void Buzzer_Stop(void);  // ֹͣвյȴ
+uint8_t Buzzer_IsActive(void);  // ǷڲţSysTickڼ䲻ܽSTOP
+void Buzzer_SetFrequency(uint32_t frequency);  // Buzzer_BeepƵ
+void Buzzer_SetDutyCycle(uint8_t duty_cycle);  // Buzzer_Beepռձ
+void Buzzer_ClockChanged(const RCC_ClocksTypeDef* clocks);  // ʱл¼
+void Buzzer_TimerHandler(void);  // ƽҪSC_it.cSysTickжеã
 
 #endif /* __BUZZER_PWM_H */
-
@@ -0,0 +1,162 @@
+//debug_uart.c
+
+#include "debug_uart.h"
+#include "event_queue.h"
+#include "mem_monitor.h"
+
+#define DEBUG_UART_TX_MASK    (DEBUG_UART_TX_BUFFER_SIZE - 1)
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static DebugUart_InitTypeDef DebugUart_Config;
+static uint8_t TxBuffer[DEBUG_UART_TX_BUFFER_SIZE];
+static volatile uint16_t TxHead = 0;              // ѭд
+static volatile uint16_t TxTail = 0;              // ж϶
+static volatile uint8_t TxBusy = 0;               // ڷͣȴжϣ
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  PCLK0ò
+  */
+static void DebugUart_ApplyBaud(uint32_t pclk)
+{
+    UART_InitTypeDef UART_InitStructure;
+
+    UART_InitStructure.UART_ClockFrequency = pclk;
+    UART_InitStructure.UART_BaudRate = DebugUart_Config.BaudRate;
+    UART_InitStructure.UART_Mode = UART_Mode_10B;     // 8λݣ1λֹͣλ
+    UART_Init(DebugUart_Config.UARTx, &UART_InitStructure);
+}
+
+/**
+  * @brief  Դڳʼжշ;λ
+  */
+void DebugUart_Init(DebugUart_InitTypeDef* DebugUart_InitStruct)
+{
+    RCC_ClocksTypeDef RCC_Clocks;
+
+    DebugUart_Config = *DebugUart_InitStruct;
+    TxHead = 0;
+    TxTail = 0;
+    TxBusy = 0;
+    MemMonitor_AddModule("debug_uart", sizeof(TxBuffer));
+
+    RCC_GetClocksFreq(&RCC_Clocks);
+    DebugUart_ApplyBaud(RCC_Clocks.PCLK0_Frequency);
+
+    UART_ClearFlag(DebugUart_Config.UARTx, UART_Flag_TX | UART_Flag_RX);
+    UART_ITConfig(DebugUart_Config.UARTx, UART_IT_EN | UART_IT_TX | UART_IT_RX, ENABLE);
+    UART_TXCmd(DebugUart_Config.UARTx, ENABLE);
+    UART_RXCmd(DebugUart_Config.UARTx, ENABLE);
+
+    NVIC_EnableIRQ(UART0_2_4_IRQn);
+}
+
+/**
+  * @brief  ʱлµPCLK0¼㲨ʣעᵽʱӹ
+  */
+void DebugUart_ClockChanged(const RCC_ClocksTypeDef* clocks)
+{
+    /* ȴǰֽڷ꣬л;ֽ */
+    DebugUart_Flush();
+    DebugUart_ApplyBaud(clocks->PCLK0_Frequency);
+}
+
+/**
+  * @brief  дһַ
+  */
+void DebugUart_WriteChar(char c)
+{
+    uint16_t head = TxHead;
+    uint32_t primask;
+
+    /* ʱȴжڳռ */
+    while((uint16_t)(head - TxTail) >= DEBUG_UART_TX_BUFFER_SIZE) {
+    }
+
+    TxBuffer[head & DEBUG_UART_TX_MASK] = (uint8_t)c;
+    TxHead = head + 1;
+
+    /* ͿʱһֽڣɷжϽ */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if(!TxBusy) {
+        TxBusy = 1;
+        UART_SendData(DebugUart_Config.UARTx, TxBuffer[TxTail & DEBUG_UART_TX_MASK]);
+        TxTail++;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  дַ
+  */
+void DebugUart_WriteString(const char* str)
+{
+    while(*str != '\0') {
+        DebugUart_WriteChar(*str++);
+    }
+}
+
+/**
+  * @brief  дʮ޷
+  */
+void DebugUart_WriteUint(uint32_t value)
+{
+    char digits[10];
+    uint8_t count = 0;
+
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while(value != 0);
+
+    while(count > 0) {
+        DebugUart_WriteChar(digits[--count]);
+    }
+}
+
+/**
+  * @brief  д뻻
+  */
+void DebugUart_WriteNewLine(void)
+{
+    DebugUart_WriteChar('\r');
+    DebugUart_WriteChar('\n');
+}
+
+/**
+  * @brief  ȴȫ
+  */
+void DebugUart_Flush(void)
+{
+    while(TxBusy) {
+    }
+}
+
+/**
+  * @brief  жϴҪSC_it.cеã
+  */
+void DebugUart_IRQHandler(void)
+{
+    UART_TypeDef* UARTx = DebugUart_Config.UARTx;
+
+    if(UART_GetFlagStatus(UARTx, UART_Flag_RX) == SET) {
+        UART_ClearFlag(UARTx, UART_Flag_RX);
+        EventQueue_Post(EVENT_UART_RX, (uint8_t)UART_ReceiveData(UARTx), 0);
+    }
+
+    if(UART_GetFlagStatus(UARTx, UART_Flag_TX) == SET) {
+        UART_ClearFlag(UARTx, UART_Flag_TX);
+        if(TxTail != TxHead) {
+            UART_SendData(UARTx, TxBuffer[TxTail & DEBUG_UART_TX_MASK]);
+            TxTail++;
+        } else {
+            TxBusy = 0;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+//debug_uart.h
+
+#ifndef __DEBUG_UART_H
+#define __DEBUG_UART_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_uart.h"
+#include "sc32f1xxx_rcc.h"
+
+/** @defgroup Դض
+  * @{
+  */
+#define DEBUG_UART_TX_BUFFER_SIZE   256     // ͻλС2ݣ
+
+/** @}
+  */
+
+/** @brief Դýṹ */
+typedef struct {
+    UART_TypeDef* UARTx;         // ʵ
+    uint32_t BaudRate;           // 
+} DebugUart_InitTypeDef;
+
+/* ʼ */
+void DebugUart_Init(DebugUart_InitTypeDef* DebugUart_InitStruct);
+void DebugUart_ClockChanged(const RCC_ClocksTypeDef* clocks);  // ʱл¼㲨
+
+/* ͺѭĵãʱȴͣ */
+void DebugUart_WriteChar(char c);
+void DebugUart_WriteString(const char* str);
+void DebugUart_WriteUint(uint32_t value);
+void DebugUart_WriteNewLine(void);
+void DebugUart_Flush(void);
+
+/* жϴҪSC_it.cеãֽͶEVENT_UART_RX */
+void DebugUart_IRQHandler(void);
+
+#endif /* __DEBUG_UART_H */
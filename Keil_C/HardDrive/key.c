@@ -2,43 +2,297 @@
 
 #include "key.h"
 
+/* б־ */
+#define KEY_FLAG_LONG_SENT     0x01U   // ΰѲ
+#define KEY_FLAG_CLICKED       0x02U   // ͷһΣ˫
+#define KEY_FLAG_DOUBLE        0x04U   // ΰ¹˫ӳٵİ¼һ
+
+/** @brief ɨ״̬ʱmsƣɨۼӣ */
+typedef struct {
+    uint8_t Integrator;            // 0ΪͷţIntegratorMaxΪ
+    uint8_t IntegratorMax;
+    uint8_t Flags;
+    uint16_t HeldMs;               // ΰµĳʱ
+    uint16_t RepeatMs;             // ϴ
+    uint16_t ReleasedMs;           // ϴͷţ˫ڣ
+} Key_ScanTypeDef;
+
+/*
+ * áɨ״̬Ǽ˳򣨰idxţ
+ * /ӳ/롢ϼ¼ʹðIDKey_IDkeyIndexӦ
+ */
+
 /* ఴṹ */
 static struct {
     Key_InitTypeDef config[KEY_ID_MAX];  // 4
-    Key_Callback PressCallback;
-    Key_Callback ReleaseCallback;
+    Key_ScanTypeDef scan[KEY_ID_MAX];
+    Key_EventCallback EventCallback;
     uint8_t keyCount;                    // עİ
+    uint8_t keyIndex[KEY_ID_MAX];        // ID -> +10ʾδǼǣ
+    uint8_t chords[KEY_MAX_CHORDS];      // ϼ
+    uint8_t chordCount;
+    uint8_t chordMembers;                // һϼİ
+    uint8_t pressedMask;                 // µİ
+    uint8_t pendingMask;                 // ¼ӳٵϴڽİ
+    uint8_t suppressMask;                // Ϊϼϱͷǰٲ¼
+    uint16_t chordMs;                    // ౾ֵһ
+    uint16_t intFalling;                 // ½ػѵINTͨ
+    uint16_t intRising;                  // ػѵINTͨ
+    uint8_t intKey[16];                  // INTͨ -> ţͨвЧ
+    uint8_t divider;                     // SysTickƵ
+    volatile uint8_t scanning;           // ɨУжѹرգ
 } Key_Handler = {0};
 
+/* λλλţde BruijnУM0+ûCLZָ */
+static const uint8_t Key_BitIndexTable[32] = {
+     0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+    31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9
+};
+#define KEY_BIT_INDEX(bit)   Key_BitIndexTable[((uint32_t)(bit) * 0x077CB531U) >> 27]
+
+/**
+  * @brief  INTͨڵж
+  */
+static IRQn_Type Key_ChannelIRQn(uint8_t channel)
+{
+    if(channel == 0) return INT0_IRQn;
+    if(channel < 8) return INT1_7_IRQn;
+    if(channel < 12) return INT8_11_IRQn;
+    return INT12_15_IRQn;
+}
+
+/**
+  * @brief  ¼
+  */
+static void Key_Emit(uint8_t id, Key_Event event)
+{
+    if(Key_Handler.EventCallback != 0) {
+        Key_Handler.EventCallback(id, event);
+    }
+}
+
+/**
+  * @brief  Ŷȡ״̬δ
+  */
+static Key_State Key_ReadIndex(uint8_t idx)
+{
+    const Key_InitTypeDef* config = &Key_Handler.config[idx];
+    BitAction pin_state = GPIO_ReadDataBit(config->GPIOx, config->GPIO_Pin);
+
+    if((pin_state == SET && config->ActiveLevel == KEY_PRESSED) ||
+       (pin_state == RESET && config->ActiveLevel == KEY_RELEASED)) {
+        return KEY_RELEASED;
+    } else {
+        return KEY_PRESSED;
+    }
+}
+
+/**
+  * @brief  ӳٵİ¼ϴڽǰͷţ
+  */
+static void Key_FlushPending(void)
+{
+    for(uint8_t i = 0; i < Key_Handler.keyCount; i++) {
+        if(Key_Handler.pendingMask & KEY_MASK(Key_Handler.config[i].KeyID)) {
+            Key_Emit(Key_Handler.config[i].KeyID, KEY_EVENT_PRESS);
+            if(Key_Handler.scan[i].Flags & KEY_FLAG_DOUBLE) {
+                Key_Emit(Key_Handler.config[i].KeyID, KEY_EVENT_DOUBLE_CLICK);
+            }
+        }
+    }
+    Key_Handler.pendingMask = 0;
+}
+
+/**
+  * @brief  򿪻رȫıж
+  */
+static void Key_EdgeITConfig(FunctionalState NewState)
+{
+    for(uint8_t i = 0; i < Key_Handler.keyCount; i++) {
+        INT_ClearFlag(Key_Handler.config[i].INT_Channel);
+        INT_ITConfig(Key_Handler.config[i].INT_Channel,
+                     (Key_Handler.config[i].ActiveLevel == KEY_PRESSED) ? INT_IT_Falling : INT_IT_Rising,
+                     NewState);
+    }
+}
+
+/**
+  * @brief  £
+  */
+static void Key_OnPress(uint8_t idx)
+{
+    Key_ScanTypeDef* scan = &Key_Handler.scan[idx];
+    Key_InitTypeDef* config = &Key_Handler.config[idx];
+    uint8_t mask = KEY_MASK(config->KeyID);
+
+    if(Key_Handler.pressedMask == 0) {
+        Key_Handler.chordMs = 0;
+    }
+    Key_Handler.pressedMask |= mask;
+
+    scan->HeldMs = 0;
+    scan->RepeatMs = 0;
+    scan->Flags &= ~(KEY_FLAG_LONG_SENT | KEY_FLAG_DOUBLE);
+    if((scan->Flags & KEY_FLAG_CLICKED) && scan->ReleasedMs <= config->DoubleClickMs) {
+        scan->Flags |= KEY_FLAG_DOUBLE;
+    }
+    scan->Flags &= ~KEY_FLAG_CLICKED;
+
+    /* ϼԱϴڽپǵ */
+    if(Key_Handler.chordMembers & mask) {
+        Key_Handler.pendingMask |= mask;
+        if(Key_Handler.chordMs > KEY_CHORD_WINDOW_MS) return;
+
+        for(uint8_t c = 0; c < Key_Handler.chordCount; c++) {
+            if(Key_Handler.pressedMask == Key_Handler.chords[c]) {
+                Key_Handler.pendingMask = 0;
+                Key_Handler.suppressMask |= Key_Handler.pressedMask;
+                Key_Emit(Key_Handler.chords[c], KEY_EVENT_CHORD);
+                return;
+            }
+        }
+        return;
+    }
+
+    Key_Emit(config->KeyID, KEY_EVENT_PRESS);
+    if(scan->Flags & KEY_FLAG_DOUBLE) {
+        Key_Emit(config->KeyID, KEY_EVENT_DOUBLE_CLICK);
+    }
+}
+
+/**
+  * @brief  ͷţ
+  */
+static void Key_OnRelease(uint8_t idx)
+{
+    Key_ScanTypeDef* scan = &Key_Handler.scan[idx];
+    uint8_t mask = KEY_MASK(Key_Handler.config[idx].KeyID);
+
+    Key_Handler.pressedMask &= ~mask;
+
+    if(Key_Handler.suppressMask & mask) {
+        Key_Handler.suppressMask &= ~mask;
+        return;
+    }
+    if(Key_Handler.pendingMask & mask) {
+        Key_FlushPending();   // ϴɿǵ
+    }
+
+    Key_Emit(Key_Handler.config[idx].KeyID, KEY_EVENT_RELEASE);
+
+    /* ˫ĵڶͷŲٿµ˫ */
+    if(Key_Handler.config[idx].DoubleClickMs != 0 && !(scan->Flags & KEY_FLAG_DOUBLE)) {
+        scan->Flags |= KEY_FLAG_CLICKED;
+        scan->ReleasedMs = 0;
+    }
+}
+
+/**
+  * @brief  סڼ䣺
+  */
+static void Key_OnHold(uint8_t idx)
+{
+    Key_ScanTypeDef* scan = &Key_Handler.scan[idx];
+    Key_InitTypeDef* config = &Key_Handler.config[idx];
+
+    if(scan->HeldMs < 0xFFFFU - KEY_SCAN_PERIOD_MS) {
+        scan->HeldMs += KEY_SCAN_PERIOD_MS;
+    }
+    if((Key_Handler.pendingMask | Key_Handler.suppressMask) & KEY_MASK(config->KeyID)) return;
+    if(config->LongPressMs == 0 || scan->HeldMs < config->LongPressMs) return;
+
+    if(!(scan->Flags & KEY_FLAG_LONG_SENT)) {
+        scan->Flags |= KEY_FLAG_LONG_SENT;
+        Key_Emit(config->KeyID, KEY_EVENT_LONG_PRESS);
+    } else if(config->RepeatMs != 0) {
+        scan->RepeatMs += KEY_SCAN_PERIOD_MS;
+        if(scan->RepeatMs >= config->RepeatMs) {
+            scan->RepeatMs = 0;
+            Key_Emit(config->KeyID, KEY_EVENT_REPEAT);
+        }
+    }
+}
+
+/**
+  * @brief  ɨһȫ
+  * @retval 1: а¡Сȴ˫ϴڣ  0: ȫ
+  */
+static uint8_t Key_Scan(void)
+{
+    uint8_t busy = 0;
+
+    if(Key_Handler.chordMs < 0xFFFFU - KEY_SCAN_PERIOD_MS) {
+        Key_Handler.chordMs += KEY_SCAN_PERIOD_MS;
+    }
+
+    for(uint8_t i = 0; i < Key_Handler.keyCount; i++) {
+        Key_ScanTypeDef* scan = &Key_Handler.scan[i];
+        uint8_t pressed = (Key_Handler.pressedMask & KEY_MASK(Key_Handler.config[i].KeyID)) != 0;
+
+        /* ¼ӣͷż˲Ÿı״̬ */
+        if(Key_ReadIndex(i) == KEY_PRESSED) {
+            if(scan->Integrator < scan->IntegratorMax) scan->Integrator++;
+        } else {
+            if(scan->Integrator > 0) scan->Integrator--;
+        }
+
+        if(!pressed && scan->Integrator >= scan->IntegratorMax) {
+            Key_OnPress(i);
+        } else if(pressed && scan->Integrator == 0) {
+            Key_OnRelease(i);
+        } else if(pressed) {
+            Key_OnHold(i);
+        } else if(scan->Flags & KEY_FLAG_CLICKED) {
+            scan->ReleasedMs += KEY_SCAN_PERIOD_MS;
+            if(scan->ReleasedMs > Key_Handler.config[i].DoubleClickMs) {
+                scan->Flags &= ~KEY_FLAG_CLICKED;
+            }
+        }
+
+        if(scan->Integrator != 0 || (scan->Flags & KEY_FLAG_CLICKED)) {
+            busy = 1;
+        }
+    }
+
+    if(Key_Handler.pendingMask != 0 && Key_Handler.chordMs > KEY_CHORD_WINDOW_MS) {
+        Key_FlushPending();
+    }
+    return busy || Key_Handler.pendingMask != 0;
+}
+
 /**
   * @brief  ʼ
   */
 void Key_Init(Key_InitTypeDef* Key_InitStruct)
 {
 	if(Key_Handler.keyCount >= KEY_ID_MAX) return;
-	
+	if(Key_InitStruct->KeyID >= KEY_ID_MAX || Key_Handler.keyIndex[Key_InitStruct->KeyID] != 0) return;  // IDЧѵǼ
+	if((Key_Handler.intFalling | Key_Handler.intRising) & Key_InitStruct->INT_Channel) return;  // ͨѱռ
+
 	uint8_t idx = Key_Handler.keyCount;
-	
+	uint8_t channel = KEY_BIT_INDEX(Key_InitStruct->INT_Channel);
+	uint16_t debounce;
+
     /*  */
-    Key_Handler.config[idx].GPIOx = Key_InitStruct->GPIOx;
-    Key_Handler.config[idx].GPIO_Pin = Key_InitStruct->GPIO_Pin;
-    Key_Handler.config[idx].INT_Channel = Key_InitStruct->INT_Channel;
-    Key_Handler.config[idx].INT_Port = Key_InitStruct->INT_Port;
-    Key_Handler.config[idx].ActiveLevel = Key_InitStruct->ActiveLevel;
-    Key_Handler.config[idx].KeyID = Key_InitStruct->KeyID;
-    
+    Key_Handler.config[idx] = *Key_InitStruct;
+
+    /*  = ʱ / ɨ */
+    debounce = Key_InitStruct->DebounceMs ? Key_InitStruct->DebounceMs : KEY_DEFAULT_DEBOUNCE_MS;
+    Key_Handler.scan[idx].IntegratorMax = (debounce + KEY_SCAN_PERIOD_MS - 1) / KEY_SCAN_PERIOD_MS;
+    if(Key_Handler.scan[idx].IntegratorMax == 0) Key_Handler.scan[idx].IntegratorMax = 1;
+
     /* GPIOʼ - ģʽ */
     GPIO_InitTypeDef GPIO_InitStructure;
     GPIO_InitStructure.GPIO_Pin = Key_Handler.config[idx].GPIO_Pin;
     GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_PU;  // 
     GPIO_InitStructure.GPIO_DriveLevel = GPIO_DriveLevel_0;
     GPIO_Init(Key_Handler.config[idx].GPIOx, &GPIO_InitStructure);
-    
+
     /* ⲿжϳʼ */
     INT_InitTypeDef INT_InitStructure;
     INT_InitStructure.INT_Channel = Key_Handler.config[idx].INT_Channel;
     INT_InitStructure.INT_INTSEL = Key_Handler.config[idx].INT_Port;
-    
+
     /* Чƽôʽ */
     if(Key_Handler.config[idx].ActiveLevel == KEY_PRESSED) {
         // Ϊ͵ƽ½ش
@@ -47,65 +301,117 @@ void Key_Init(Key_InitTypeDef* Key_InitStruct)
         // Ϊߵƽش
         INT_InitStructure.INT_Trigger = INT_Trigger_Rising;
     }
-    
+
     INT_Init(&INT_InitStructure);
-    
-    /* ʹⲿж */
-    INT_ITConfig(Key_Handler.config[idx].INT_Channel, 
-                 (Key_Handler.config[idx].ActiveLevel == KEY_PRESSED) ? INT_IT_Falling : INT_IT_Rising, 
+
+    /* ǼǷַͨ -> طֱ¼ */
+    Key_Handler.intKey[channel] = idx;
+    if(INT_InitStructure.INT_Trigger == INT_Trigger_Falling) {
+        Key_Handler.intFalling |= Key_InitStruct->INT_Channel;
+    } else {
+        Key_Handler.intRising |= Key_InitStruct->INT_Channel;
+    }
+
+    /* ʹⲿжϣֻڻɨ裩 */
+    INT_ClearFlag(Key_Handler.config[idx].INT_Channel);
+    INT_ITConfig(Key_Handler.config[idx].INT_Channel,
+                 (Key_Handler.config[idx].ActiveLevel == KEY_PRESSED) ? INT_IT_Falling : INT_IT_Rising,
                  ENABLE);
+    NVIC_EnableIRQ(Key_ChannelIRQn(channel));
+    Key_Handler.keyIndex[Key_InitStruct->KeyID] = idx + 1;
     Key_Handler.keyCount++;
 }
 
 /**
-  * @brief  ȡǰ״̬
+  * @brief  ǼϼԱİ¼ӳKEY_CHORD_WINDOW_MS
+  * @param  keyMask: KEY_MASK(a) | KEY_MASK(b) ...
+  * @retval 1: ѵǼ  0: ϼЧ
+  */
+uint8_t Key_AddChord(uint8_t keyMask)
+{
+    if(Key_Handler.chordCount >= KEY_MAX_CHORDS) return 0;
+    if((keyMask & (keyMask - 1)) == 0) return 0;   // 
+
+    Key_Handler.chords[Key_Handler.chordCount++] = keyMask;
+    Key_Handler.chordMembers |= keyMask;
+    return 1;
+}
+
+/**
+  * @brief  ȡǰ״̬δŵƽ
+  * @param  keyId: IDǼ˳޹أ
   */
 Key_State Key_Read(Key_ID keyId)
 {
-	if(keyId >= Key_Handler.keyCount) return KEY_RELEASED;  // ߽
-    BitAction pin_state = GPIO_ReadDataBit(Key_Handler.config[keyId].GPIOx, Key_Handler.config[keyId].GPIO_Pin);
-    
-    if((pin_state == SET && Key_Handler.config[keyId].ActiveLevel == KEY_PRESSED) ||
-       (pin_state == RESET && Key_Handler.config[keyId].ActiveLevel == KEY_RELEASED)) {
-        return KEY_RELEASED;
-    } else {
-        return KEY_PRESSED;
-    }
+	if(keyId >= KEY_ID_MAX || Key_Handler.keyIndex[keyId] == 0) return KEY_RELEASED;  // δǼ
+    return Key_ReadIndex(Key_Handler.keyIndex[keyId] - 1);
 }
 
 /**
-  * @brief  ð»ص
+  * @brief  ð¼ص
   */
-void Key_SetPressCallback(Key_Callback callback)
+void Key_SetEventCallback(Key_EventCallback callback)
 {
-    Key_Handler.PressCallback = callback;
+    Key_Handler.EventCallback = callback;
 }
 
 /**
-  * @brief  ðͷŻص  
+  * @brief  Ƿɨ裨ɨSysTickڼ䲻ܽSTOP
   */
-void Key_SetReleaseCallback(Key_Callback callback)
+uint8_t Key_IsScanning(void)
 {
-    Key_Handler.ReleaseCallback = callback;
+    return Key_Handler.scanning;
 }
 
 /**
-  * @brief  ⲿжϴҪSC_it.cеã
+  * @brief  ⲿжϷַҪSC_it.cĸINTжеã
+  *         ֻжѵǼҰǼǵĴλͨʱͨ
+  * @param  lines: ж߰ͨKEY_INT_LINES_xxx
   */
-void Key_IRQHandler(Key_ID keyId)
+void Key_INTDispatch(uint16_t lines)
 {
-	if(keyId >= Key_Handler.keyCount) return;
-	
-    /* жϱ־ */
-    INT_ClearFlag(Key_Handler.config[keyId].INT_Channel);
-    
-    /* ȡǰ״̬ */
-    Key_State current_state = Key_Read(keyId);
-    
-    /* öӦĻص */
-    if(current_state == KEY_PRESSED && Key_Handler.PressCallback != 0) {
-        Key_Handler.PressCallback(keyId);
-    } else if(current_state == KEY_RELEASED && Key_Handler.ReleaseCallback != 0) {
-        Key_Handler.ReleaseCallback(keyId);
+    uint32_t pending = ((INT->INTF_STS & Key_Handler.intFalling) |
+                        (INT->INTR_STS & Key_Handler.intRising)) & lines;
+    uint32_t bit;
+
+    if(pending == 0) return;
+
+    while(pending != 0) {
+        bit = pending & (~pending + 1U);        // ͵Ĵͨ
+        pending &= pending - 1U;
+        INT_ClearFlag(bit);
+
+        /* رһΰ² */
+        Key_ScanTypeDef* scan = &Key_Handler.scan[Key_Handler.intKey[KEY_BIT_INDEX(bit)]];
+        if(scan->Integrator < scan->IntegratorMax - 1) scan->Integrator++;
+    }
+
+    if(Key_Handler.scanning) return;
+
+    /* ڼıزٽжϣ״̬ȫɨõ */
+    Key_EdgeITConfig(DISABLE);
+    Key_Handler.divider = 0;
+    Key_Handler.scanning = 1;
+}
+
+/**
+  * @brief  SysTickжеãɨÿKEY_SCAN_PERIOD_MSɨһΣȫкָж
+  */
+void Key_SysTickHandler(void)
+{
+    if(!Key_Handler.scanning) return;
+    if(++Key_Handler.divider < KEY_SCAN_PERIOD_MS) return;
+    Key_Handler.divider = 0;
+
+    if(Key_Scan()) return;
+
+    /* жǰѾµıػᱻ¼һ */
+    Key_EdgeITConfig(ENABLE);
+    for(uint8_t i = 0; i < Key_Handler.keyCount; i++) {
+        if(Key_ReadIndex(i) == KEY_PRESSED) {
+            Key_EdgeITConfig(DISABLE);
+            return;
+        }
     }
+    Key_Handler.scanning = 0;
 }
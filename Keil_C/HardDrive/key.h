@@ -7,6 +7,25 @@
 #include "sc32f1xxx_gpio.h"
 #include "sc32f1xxx_int.h"
 
+/** @defgroup ɨض
+  * @{
+  */
+#define KEY_SCAN_PERIOD_MS       2       // ɨڣSysTickƵ
+#define KEY_CHORD_WINDOW_MS      80      // ϼµʱ
+#define KEY_MAX_CHORDS           4       // ϼ
+#define KEY_DEFAULT_DEBOUNCE_MS  20      // δʱʱʹ
+
+#define KEY_MASK(id)             (1U << (id))    // ϼ
+
+/* INTж߰ͨKey_INTDispatch */
+#define KEY_INT_LINES_0          0x0001U
+#define KEY_INT_LINES_1_7        0x00FEU
+#define KEY_INT_LINES_8_11       0x0F00U
+#define KEY_INT_LINES_12_15      0xF000U
+
+/** @}
+  */
+
 /** @brief ״̬ */
 typedef enum {
     KEY_RELEASED = 0,  // ͷ
@@ -16,14 +35,24 @@ typedef enum {
 /* ID */
 typedef enum {
     KEY_ID_TARE = 0,      // ȥƤ
-    KEY_ID_CALIB,         // У׼  
+    KEY_ID_CALIB,         // У׼
     KEY_ID_MEASURE,       // ʼ
     KEY_ID_POWER,         // Դ/ܰ
     KEY_ID_MAX
 } Key_ID;
 
-/** @brief صָ */
-typedef void (*Key_Callback)(Key_ID keyId);
+/* ¼ */
+typedef enum {
+    KEY_EVENT_PRESS = 0,      // £ϼԱӳٵϴڽ
+    KEY_EVENT_RELEASE,        // ͷ
+    KEY_EVENT_LONG_PRESS,     // סﵽLongPressMs
+    KEY_EVENT_REPEAT,         // ÿRepeatMsһ
+    KEY_EVENT_DOUBLE_CLICK,   // ͷźDoubleClickMsٴΰ£PRESS֮
+    KEY_EVENT_CHORD           // ϼ£idΪ
+} Key_Event;
+
+/** @brief ¼صSysTickжеãidΪIDϼ¼Ϊ */
+typedef void (*Key_EventCallback)(uint8_t id, Key_Event event);
 
 /** @brief ýṹ */
 typedef struct {
@@ -33,13 +62,21 @@ typedef struct {
     INT_INTSEL_Typedef INT_Port;   // ⲿж϶˿
     Key_State ActiveLevel;         // Чƽʱĵƽ
     Key_ID KeyID;                  // ID
+    uint16_t DebounceMs;           // ʱ
+    uint16_t LongPressMs;          // ʱ䣬0
+    uint16_t RepeatMs;             // 0
+    uint16_t DoubleClickMs;        // ˫0˫
 } Key_InitTypeDef;
 
 /*  */
 void Key_Init(Key_InitTypeDef* Key_InitStruct);
+uint8_t Key_AddChord(uint8_t keyMask);
 Key_State Key_Read(Key_ID keyId);
-void Key_SetPressCallback(Key_Callback callback);
-void Key_SetReleaseCallback(Key_Callback callback);
-void Key_IRQHandler(Key_ID keyId);
+void Key_SetEventCallback(Key_EventCallback callback);
+uint8_t Key_IsScanning(void);
+
+/* жϴҪSC_it.cеãжֻɨ裬ɨSysTickн */
+void Key_INTDispatch(uint16_t lines);
+void Key_SysTickHandler(void);
 
 #endif /* __KEY_H */
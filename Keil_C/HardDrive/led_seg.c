@@ -0,0 +1,217 @@
+//led_seg.c
+
+#include "led_seg.h"
+#include "soft_timer.h"
+#include "mem_monitor.h"
+#include "num_format.h"
+
+/* ţCOM0-4ΪλѡCOM5ΪָʾƣSEG0-7Ϊa..dp */
+#define LEDSEG_COM_PINS          0x0000003FU     // COM0-COM5
+#define LEDSEG_SEG_PINS          0x000000FFU     // SEG0-SEG7
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static uint8_t LedSeg_Digits[LEDSEG_DIGITS];     // λ
+static uint8_t LedSeg_Indicators = 0;             // ָʾƣλnӦSEGn
+static uint8_t LedSeg_BlinkMask = 0;              // ˸λ
+static uint8_t LedSeg_BlinkOff = 0;               // ˸İ
+static uint8_t LedSeg_Shadow[LEDSEG_RAM_SIZE];    // дLEDʾRAM
+static uint32_t LedSeg_PwmChannel = 0;
+static uint32_t LedSeg_WriteCount = 0;            // ۼдĴ
+static SoftTimer_t LedSeg_BlinkTimer;
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  ˸ʱصл/ˢ
+  */
+static void LedSeg_BlinkToggle(void* arg)
+{
+    (void)arg;
+    LedSeg_BlinkOff = !LedSeg_BlinkOff;
+    LedSeg_Flush();
+}
+
+/**
+  * @brief  LEDܳʼ1/8ռձӲɨ裬LEDPWMȣʾRAM
+  */
+void LedSeg_Init(LedSeg_InitTypeDef* LedSeg_InitStruct)
+{
+    LED_InitTypeDef LED_InitStructure;
+    LEDPWM_InitTypeDef LEDPWM_InitStructure;
+
+    LED_StructInit(&LED_InitStructure);
+    LED_InitStructure.LED_FrameFre = LedSeg_InitStruct->FrameFre;
+    LED_InitStructure.LED_Duty = LED_Duty_1_8;
+    LED_InitStructure.LED_ComPin = LEDSEG_COM_PINS;
+    LED_InitStructure.LED_SegPin = LEDSEG_SEG_PINS;
+    LED_Init(&LED_InitStructure);
+
+    for(uint8_t i = 0; i < LEDSEG_RAM_SIZE; i++) {
+        LedSeg_Shadow[i] = 0;
+        LED_Write((LED_RAMRegister_Typedef)i, 0);
+    }
+    for(uint8_t i = 0; i < LEDSEG_DIGITS; i++) {
+        LedSeg_Digits[i] = 0;
+    }
+
+    LedSeg_PwmChannel = LedSeg_InitStruct->PwmChannel;
+    LEDPWM_StructInit(&LEDPWM_InitStructure);
+    LEDPWM_InitStructure.LEDPWM_Prescaler = LedSeg_InitStruct->PwmPrescaler;
+    LEDPWM_InitStructure.LEDPWM_AlignedMode = LEDPWM_AlignmentMode_Edge;
+    LEDPWM_InitStructure.LEDPWM_Cycle = LEDSEG_PWM_CYCLE;
+    LEDPWM_InitStructure.LEDPWM_OutputChannel = LedSeg_PwmChannel;
+    LEDPWM_InitStructure.LEDPWM_LowPolarityChannl = 0;
+    LEDPWM_Init(&LEDPWM_InitStructure);
+    LedSeg_SetBrightness(LedSeg_InitStruct->Brightness);
+
+    SoftTimer_Create(&LedSeg_BlinkTimer, LedSeg_BlinkToggle, 0);
+
+    LEDPWM_Cmd(ENABLE);
+    LED_Cmd(ENABLE);
+    MemMonitor_AddModule("led_seg", sizeof(LedSeg_Digits) + sizeof(LedSeg_Shadow) + sizeof(LedSeg_BlinkTimer));
+}
+
+/**
+  * @brief  򿪻رɨȵƣػʱرգ
+  */
+void LedSeg_Cmd(FunctionalState NewState)
+{
+    LED_Cmd(NewState);
+    LEDPWM_Cmd(NewState);
+}
+
+/**
+  * @brief  ȣLEDPWMռձȣʾȳ
+  * @param  percent: 0-100
+  */
+void LedSeg_SetBrightness(uint8_t percent)
+{
+    if(percent > 100) percent = 100;
+    LEDPWM_SetDuty((LEDPWM_Channel_Typedef)LedSeg_PwmChannel,
+                   (uint8_t)((uint16_t)percent * LEDSEG_PWM_CYCLE / 100));
+}
+
+/**
+  * @brief  ʾݣָ֡ʾƺ˸
+  */
+void LedSeg_Clear(void)
+{
+    for(uint8_t i = 0; i < LEDSEG_DIGITS; i++) {
+        LedSeg_Digits[i] = 0;
+    }
+    LedSeg_Indicators = 0;
+    LedSeg_SetBlink(0);
+}
+
+/**
+  * @brief  ҶʾdecimalsλСǰλʾ
+  * @param  value: ʾֵѰСλŴʾ12.3ʱ1231
+  */
+void LedSeg_ShowNumber(int32_t value, uint8_t decimals)
+{
+    uint8_t flags = NumFormat_Segments(value, decimals, LedSeg_Digits, LEDSEG_DIGITS);
+
+    LedSeg_SetIndicator(LEDSEG_IND_MINUS, (flags & (NUMFMT_NEGATIVE | NUMFMT_OVERFLOW)) == NUMFMT_NEGATIVE);
+}
+
+/**
+  * @brief  ʾֶȡ10kg°gʾ1λСϰkgʾ3λС
+  * @param  milligram: (mg)
+  * @param  step: ֶϵ1/2/5gstep0.1gkgstep1g
+  */
+void LedSeg_ShowWeight(int32_t milligram, uint8_t step)
+{
+    NumFormat_Unit unit;
+    uint8_t flags = NumFormat_Weight(milligram, step, LedSeg_Digits, LEDSEG_DIGITS, &unit);
+
+    LedSeg_SetIndicator(LEDSEG_IND_MINUS, (flags & (NUMFMT_NEGATIVE | NUMFMT_OVERFLOW)) == NUMFMT_NEGATIVE);
+    LedSeg_SetIndicator(LEDSEG_IND_G, !(flags & NUMFMT_OVERFLOW) && unit == NUMFMT_UNIT_G);
+    LedSeg_SetIndicator(LEDSEG_IND_KG, !(flags & NUMFMT_OVERFLOW) && unit == NUMFMT_UNIT_KG);
+}
+
+/**
+  * @brief  ȫʾߣ̡
+  */
+void LedSeg_ShowDashes(void)
+{
+    LedSeg_SetIndicator(LEDSEG_IND_MINUS, 0);
+    for(uint8_t i = 0; i < LEDSEG_DIGITS; i++) {
+        LedSeg_Digits[i] = NUMFMT_SEG_MINUS;
+    }
+}
+
+/**
+  * @brief  Ϩָʾ
+  */
+void LedSeg_SetIndicator(LedSeg_Indicator indicator, uint8_t on)
+{
+    if(indicator >= LEDSEG_IND_MAX) return;
+
+    if(on) {
+        LedSeg_Indicators |= (uint8_t)(1U << indicator);
+    } else {
+        LedSeg_Indicators &= (uint8_t)~(1U << indicator);
+    }
+}
+
+/**
+  * @brief  ˸λλnӦnλ֣0˸
+  * @note   ˸ʱֻ˸ʱУÿˢһ
+  */
+void LedSeg_SetBlink(uint8_t digitMask)
+{
+    digitMask &= LEDSEG_BLINK_ALL;
+    if(digitMask == LedSeg_BlinkMask) return;
+
+    LedSeg_BlinkMask = digitMask;
+    if(digitMask) {
+        if(!SoftTimer_IsActive(&LedSeg_BlinkTimer)) {
+            LedSeg_BlinkOff = 0;
+            SoftTimer_Start(&LedSeg_BlinkTimer, LEDSEG_BLINK_MS, LEDSEG_BLINK_MS);
+        }
+    } else {
+        SoftTimer_Stop(&LedSeg_BlinkTimer);
+        LedSeg_BlinkOff = 0;
+    }
+}
+
+/**
+  * @brief  ʾݺ˸״̬ʾRAMֻд仯ֽ
+  * @retval дļĴ
+  */
+uint8_t LedSeg_Flush(void)
+{
+    uint8_t visible = LedSeg_BlinkOff ? (uint8_t)~LedSeg_BlinkMask : 0xFFU;
+    uint8_t writes = 0;
+    uint8_t value;
+
+    for(uint8_t seg = 0; seg < LEDSEG_RAM_SIZE; seg++) {
+        value = 0;
+        for(uint8_t digit = 0; digit < LEDSEG_DIGITS; digit++) {
+            if((LedSeg_Digits[digit] & (1U << seg)) && (visible & (1U << digit))) {
+                value |= (uint8_t)(1U << digit);
+            }
+        }
+        if(LedSeg_Indicators & (1U << seg)) value |= (uint8_t)(1U << LEDSEG_IND_COM);
+
+        if(value != LedSeg_Shadow[seg]) {
+            LedSeg_Shadow[seg] = value;
+            LED_Write((LED_RAMRegister_Typedef)seg, value);
+            writes++;
+        }
+    }
+    LedSeg_WriteCount += writes;
+    return writes;
+}
+
+/**
+  * @brief  ۼдĴˢ¿
+  */
+uint32_t LedSeg_GetWriteCount(void)
+{
+    return LedSeg_WriteCount;
+}
@@ -0,0 +1,61 @@
+//led_seg.h
+
+#ifndef __LED_SEG_H
+#define __LED_SEG_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_led.h"
+#include "sc32f1xxx_ledpwm.h"
+
+/** @defgroup LEDض
+  * @{
+  */
+#define LEDSEG_DIGITS            5       // λCOM0-47+С㣩
+#define LEDSEG_IND_COM           5       // ָʾڵCOM
+#define LEDSEG_RAM_SIZE          8       // SEG0-7a..dpÿSEGһֽڣλnӦCOMn
+#define LEDSEG_PWM_CYCLE         100     // LEDPWMڣռձֱӵȰٷֱ
+#define LEDSEG_BLINK_MS          500     // ˸/
+
+#define LEDSEG_BLINK_ALL         ((1U << LEDSEG_DIGITS) - 1)   // ȫ˸
+
+/** @}
+  */
+
+/* ָʾƣCOM5ϵķLEDSEGnӦn */
+typedef enum {
+    LEDSEG_IND_MINUS = 0,       // 
+    LEDSEG_IND_G,               // λ g
+    LEDSEG_IND_KG,              // λ kg
+    LEDSEG_IND_STABLE,          // ȶ
+    LEDSEG_IND_ZERO,            // 
+    LEDSEG_IND_TARE,            // ȥƤ
+    LEDSEG_IND_OVERLOAD,        // 
+    LEDSEG_IND_MAX
+} LedSeg_Indicator;
+
+/** @brief LEDýṹ壨1/8ռձȣCOM0-5SEG0-7 */
+typedef struct {
+    uint16_t FrameFre;           // ɨ֡ƵLED_FrameFre_TypeDef
+    uint32_t PwmChannel;         // ȵƵLEDPWMͨLEDPWM_Channel_Typedef
+    uint16_t PwmPrescaler;       // LEDPWMƵLEDPWM_Prescaler_TypeDef
+    uint8_t Brightness;          // ʼȣ0-100
+} LedSeg_InitTypeDef;
+
+/* ʼغ */
+void LedSeg_Init(LedSeg_InitTypeDef* LedSeg_InitStruct);
+void LedSeg_Cmd(FunctionalState NewState);
+void LedSeg_SetBrightness(uint8_t percent);
+
+/* ƵʾݣLEDĴ */
+void LedSeg_Clear(void);
+void LedSeg_ShowNumber(int32_t value, uint8_t decimals);
+void LedSeg_ShowWeight(int32_t milligram, uint8_t step);
+void LedSeg_ShowDashes(void);
+void LedSeg_SetIndicator(LedSeg_Indicator indicator, uint8_t on);
+void LedSeg_SetBlink(uint8_t digitMask);
+
+/* ѱ仯ֽдLEDʾRAM */
+uint8_t LedSeg_Flush(void);
+uint32_t LedSeg_GetWriteCount(void);
+
+#endif /* __LED_SEG_H */
@@ -0,0 +1,580 @@
+//oled.c
+
+#include "oled.h"
+#include "system_timer.h"
+#include "mem_monitor.h"
+#include "num_format.h"
+
+/* ֣7η16x32ָ񣬼20λڵ2-5ҳ */
+#define OLED_DIGITS              5
+#define OLED_DIGIT_X0            12      // һλߣţ
+#define OLED_DIGIT_Y             16
+#define OLED_DIGIT_PITCH         20
+#define OLED_DIGIT_H             32
+#define OLED_MINUS_X             0
+#define OLED_MINUS_W             10
+#define OLED_UNIT_X              114     // λλã5ҳ
+#define OLED_UNIT_PAGE           5
+#define OLED_UNIT_NONE           0xFFU   // ʱʾλ
+
+#define OLED_CHAR_W              6       // 5x71м
+#define OLED_RESET_US            10      // λȣSSD1306ҪС3us
+
+/* SSD1306 */
+#define OLED_CMD_COLUMN_ADDR     0x21
+#define OLED_CMD_PAGE_ADDR       0x22
+#define OLED_CMD_DISPLAY_OFF     0xAE
+#define OLED_CMD_DISPLAY_ON      0xAF
+
+/** @brief Σx0..x1ҳpage0..page1 */
+typedef struct {
+    uint8_t x0;
+    uint8_t x1;
+    uint8_t page0;
+    uint8_t page1;
+} Oled_Rect;
+
+/** @brief μΣָϽǣλأ */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t w;
+    uint8_t h;
+} Oled_Segment;
+
+/** @brief 5x7壬ÿֽһУλ0 */
+typedef struct {
+    char ch;
+    uint8_t col[5];
+} Oled_Glyph;
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static const uint8_t Oled_InitSequence[] = {
+    0xAE,               // ʾ
+    0xD5, 0x80,         // ʱӷƵ
+    0xA8, 0x3F,         // 64
+    0xD3, 0x00,         // ʾƫ
+    0x40,               // ʼ0
+    0x8D, 0x14,         // 򿪵ɱ
+    0x20, 0x00,         // ˮƽѰַдһҳٻһҳ
+    0xA1,               // еַ127ӳ䵽SEG0
+    0xC8,               // COMɨ
+    0xDA, 0x12,         // COM
+    0x81, 0xCF,         // Աȶ
+    0xD9, 0xF1,         // Ԥ
+    0xDB, 0x40,         // VCOMH
+    0xA4,               // Դʾ
+    0xA6,               // ʾǷɫ
+    0xAF                // ʾ
+};
+
+/* a b c d e f g dpNumFormatλһ */
+static const Oled_Segment Oled_Segments[8] = {
+    { 2,  0, 12,  3 }, { 13,  2,  3, 13 }, { 13, 17,  3, 13 }, { 2, 29, 12,  3 },
+    { 0, 17,  3, 13 }, {  0,  2,  3, 13 }, {  2, 14, 12,  3 }, { 17, 29,  3,  3 }
+};
+
+static const Oled_Glyph Oled_Font[] = {
+    { 'A', { 0x7E, 0x11, 0x11, 0x11, 0x7E } },
+    { 'B', { 0x7F, 0x49, 0x49, 0x49, 0x36 } },
+    { 'E', { 0x7F, 0x49, 0x49, 0x49, 0x41 } },
+    { 'L', { 0x7F, 0x40, 0x40, 0x40, 0x40 } },
+    { 'O', { 0x3E, 0x41, 0x41, 0x41, 0x3E } },
+    { 'R', { 0x7F, 0x09, 0x19, 0x29, 0x46 } },
+    { 'S', { 0x46, 0x49, 0x49, 0x49, 0x31 } },
+    { 'T', { 0x01, 0x01, 0x7F, 0x01, 0x01 } },
+    { 'V', { 0x1F, 0x20, 0x40, 0x20, 0x1F } },
+    { 'Z', { 0x61, 0x51, 0x49, 0x45, 0x43 } },
+    { 'k', { 0x7F, 0x10, 0x28, 0x44, 0x00 } },
+    { 'g', { 0x0C, 0x52, 0x52, 0x52, 0x3E } },
+    { '-', { 0x08, 0x08, 0x08, 0x08, 0x08 } }
+};
+
+/* ״̬ǩ0ҳ */
+static const struct {
+    uint8_t x;
+    const char* text;
+} Oled_IconLabels[OLED_ICON_MAX] = {
+    { 0, "STABLE" }, { 40, "ZERO" }, { 70, "TARE" }, { 100, "OVER" }
+};
+
+static Oled_InitTypeDef Oled_Config;
+static uint8_t Oled_Frame[OLED_PAGES][OLED_WIDTH];    // Դ棬SSD1306 GDDRAMͬҳ֯
+static uint8_t Oled_TxBuf[2][OLED_WIDTH];              // ҳݴ滺壺һڷͣһ׼һҳ
+static uint8_t Oled_TxLen[2];
+static uint8_t Oled_CmdBuf[sizeof(Oled_InitSequence)];  // ͬһDMAͨͣDCΪͣ
+static uint32_t Oled_ByteLoops = 0;                     // һֽλʱӦĲѯ
+
+static Oled_Rect Oled_Dirty[OLED_MAX_DIRTY];           // ƲΣֻзʣ
+static uint8_t Oled_DirtyCount = 0;
+static Oled_Rect Oled_Send[OLED_MAX_DIRTY];            // ڷ͵һ
+static uint8_t Oled_SendCount = 0;
+static uint8_t Oled_SendIndex = 0;
+
+static Oled_Rect Oled_Current;                          // ڷ͵ľ
+static uint8_t Oled_NextPage = 0;                       // һ׼ҳ
+static uint8_t Oled_TxActive = 0;                       // ڷ͵Ļ
+static volatile uint8_t Oled_TxReady = 0;               // һ׼
+static volatile uint8_t Oled_CmdPhase = 0;              // ڷ
+static volatile uint8_t Oled_RectPending = 0;           // Oled_Current
+static volatile uint8_t Oled_DmaBusy = 0;
+static volatile uint32_t Oled_ByteCount = 0;            // ۼƷֽ
+
+/* ʾݣֻػ仯Ĳ */
+static uint8_t Oled_ShownSegs[OLED_DIGITS];
+static uint8_t Oled_ShownMinus = 0;
+static uint8_t Oled_ShownUnit = OLED_UNIT_NONE;
+static uint8_t Oled_ShownIcons = 0;
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  æȴֻڳʼλʱʹã
+  */
+static void Oled_DelayUs(uint32_t us)
+{
+    Time_Us start = Time_NowUs();
+
+    while(Time_ElapsedUs(start) < us) {}
+}
+
+/**
+  * @brief  ȴSPIһֽڣDMAжеã֮лDC
+  * @note   DMAʱһֽڻڷFIFOλĴСTXEIFλֻʣλеһֽڣ
+  *         SPIFٴλֽǰѷ꣬һֽʱ
+  */
+static void Oled_WaitSpiIdle(void)
+{
+    uint32_t loops = Oled_ByteLoops;
+
+    while(SPI_GetFlagStatus(Oled_Config.SPIx, SPI_Flag_TXEIF) == RESET) {}
+    SPI_ClearFlag(Oled_Config.SPIx, SPI_Flag_SPIF);
+    while(SPI_GetFlagStatus(Oled_Config.SPIx, SPI_Flag_SPIF) == RESET && --loops != 0) {}
+}
+
+/**
+  * @brief  ཻڣϲ󲻻෢޹
+  */
+static uint8_t Oled_RectTouches(const Oled_Rect* a, const Oled_Rect* b)
+{
+    return a->x0 <= b->x1 + 1 && b->x0 <= a->x1 + 1 &&
+           a->page0 <= b->page1 + 1 && b->page0 <= a->page1 + 1;
+}
+
+static void Oled_RectUnion(Oled_Rect* dst, const Oled_Rect* src)
+{
+    if(src->x0 < dst->x0) dst->x0 = src->x0;
+    if(src->x1 > dst->x1) dst->x1 = src->x1;
+    if(src->page0 < dst->page0) dst->page0 = src->page0;
+    if(src->page1 > dst->page1) dst->page1 = src->page1;
+}
+
+static uint16_t Oled_RectArea(const Oled_Rect* r)
+{
+    return (uint16_t)(r->x1 - r->x0 + 1) * (uint16_t)(r->page1 - r->page0 + 1);
+}
+
+/**
+  * @brief  ¼ΣоཻϲʱСľ
+  */
+static void Oled_MarkDirty(uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1)
+{
+    Oled_Rect rect = { x0, x1, page0, page1 };
+    Oled_Rect merged;
+    uint16_t growth;
+    uint16_t bestGrowth = 0xFFFFU;
+    uint8_t best = 0;
+    uint8_t i = 0;
+
+    /* ϲľοֽΣͷٲ */
+    while(i < Oled_DirtyCount) {
+        if(Oled_RectTouches(&Oled_Dirty[i], &rect)) {
+            Oled_RectUnion(&rect, &Oled_Dirty[i]);
+            Oled_Dirty[i] = Oled_Dirty[--Oled_DirtyCount];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    if(Oled_DirtyCount < OLED_MAX_DIRTY) {
+        Oled_Dirty[Oled_DirtyCount++] = rect;
+        return;
+    }
+
+    for(i = 0; i < Oled_DirtyCount; i++) {
+        merged = Oled_Dirty[i];
+        Oled_RectUnion(&merged, &rect);
+        growth = Oled_RectArea(&merged) - Oled_RectArea(&Oled_Dirty[i]);
+        if(growth < bestGrowth) {
+            bestGrowth = growth;
+            best = i;
+        }
+    }
+    Oled_RectUnion(&Oled_Dirty[best], &rect);
+}
+
+/**
+  * @brief  ѵǰεһҳƵͻ
+  * @retval 0: ǰȫ׼
+  */
+static uint8_t Oled_Stage(uint8_t buf)
+{
+    uint8_t len;
+
+    if(Oled_NextPage > Oled_Current.page1) return 0;
+
+    len = Oled_Current.x1 - Oled_Current.x0 + 1;
+    for(uint8_t i = 0; i < len; i++) {
+        Oled_TxBuf[buf][i] = Oled_Frame[Oled_NextPage][Oled_Current.x0 + i];
+    }
+    Oled_TxLen[buf] = len;
+    Oled_NextPage++;
+    return 1;
+}
+
+/**
+  * @brief  һDMA
+  */
+static void Oled_StartDma(const uint8_t* src, uint8_t len)
+{
+    DMA_Cmd(Oled_Config.DMAx, DISABLE);
+    DMA_SetSrcAddress(Oled_Config.DMAx, (uint32_t)src);
+    DMA_SetCurrDataCounter(Oled_Config.DMAx, len);
+    DMA_Cmd(Oled_Config.DMAx, ENABLE);
+    Oled_ByteCount += len;
+}
+
+/**
+  * @brief  DMADCΪͣɷжϻָDCOled_Current
+  * @note   ǰDMAУOled_DmaBusyʱSPIѷֱ꣬лDC
+  */
+static void Oled_WriteCommands(const uint8_t* cmds, uint8_t len, uint8_t withRect)
+{
+    for(uint8_t i = 0; i < len; i++) {
+        Oled_CmdBuf[i] = cmds[i];
+    }
+    Oled_RectPending = withRect;
+    Oled_CmdPhase = 1;
+    Oled_DmaBusy = 1;
+    GPIO_ResetBits(Oled_Config.CtrlGPIOx, Oled_Config.DcPin);
+    Oled_StartDma(Oled_CmdBuf, len);
+}
+
+/**
+  * @brief  ôڲʼһΣݶDMAͣȴ
+  */
+static void Oled_StartRect(const Oled_Rect* rect)
+{
+    uint8_t cmds[6] = {
+        OLED_CMD_COLUMN_ADDR, rect->x0, rect->x1,
+        OLED_CMD_PAGE_ADDR, rect->page0, rect->page1
+    };
+
+    /* ڼDMAҳ壬ǰҳ׼ */
+    Oled_Current = *rect;
+    Oled_NextPage = rect->page0;
+    Oled_TxActive = 0;
+    Oled_Stage(0);
+    Oled_TxReady = Oled_Stage(1);
+    Oled_WriteCommands(cmds, sizeof(cmds), 1);
+}
+
+/**
+  * @brief  ػһλ
+  */
+static void Oled_DrawDigit(uint8_t pos, uint8_t segs)
+{
+    uint8_t x = OLED_DIGIT_X0 + pos * OLED_DIGIT_PITCH;
+
+    Oled_FillRect(x, OLED_DIGIT_Y, OLED_DIGIT_PITCH, OLED_DIGIT_H, 0);
+    for(uint8_t s = 0; s < 8; s++) {
+        if(segs & (1U << s)) {
+            Oled_FillRect(x + Oled_Segments[s].x, OLED_DIGIT_Y + Oled_Segments[s].y,
+                          Oled_Segments[s].w, Oled_Segments[s].h, 1);
+        }
+    }
+}
+
+/**
+  * @brief  ͼʾʼSPI+DMAӲλдSSD1306ʼУȫ
+  */
+void Oled_Init(Oled_InitTypeDef* Oled_InitStruct)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    SPI_InitTypeDef SPI_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+    IRQn_Type irq;
+
+    Oled_Config = *Oled_InitStruct;
+    /* һֽ8SCKÿSCKΪ2^SPRʱӣÿβѯټʱӣʱƴ */
+    Oled_ByteLoops = 8U << (Oled_Config.Prescaler >> SPI_CON_SPR_Pos);
+
+    /* DCRST */
+    GPIO_InitStructure.GPIO_Pin = Oled_Config.DcPin | Oled_Config.RstPin;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT_PP;
+    GPIO_InitStructure.GPIO_DriveLevel = GPIO_DriveLevel_0;
+    GPIO_Init(Oled_Config.CtrlGPIOx, &GPIO_InitStructure);
+    GPIO_SetBits(Oled_Config.CtrlGPIOx, Oled_Config.DcPin | Oled_Config.RstPin);
+
+    /* SPIģʽ08λλȷ */
+    SPI_StructInit(&SPI_InitStructure);
+    SPI_InitStructure.SPI_Mode = SPI_Mode_Master;
+    SPI_InitStructure.SPI_DataSize = SPI_DataSize_8B;
+    SPI_InitStructure.SPI_CPHA = SPI_CPHA_1Edge;
+    SPI_InitStructure.SPI_CPOL = SPI_CPOL_Low;
+    SPI_InitStructure.SPI_FirstBit = SPI_FirstBit_MSB;
+    SPI_InitStructure.SPI_Prescaler = Oled_Config.Prescaler;
+    SPI_Init(Oled_Config.SPIx, &SPI_InitStructure);
+    SPI_DMACmd(Oled_Config.SPIx, SPI_DMAReq_TX, ENABLE);
+    SPI_Cmd(Oled_Config.SPIx, ENABLE);
+
+    /* DMAڴַĿ̶ΪSPIݼĴ */
+    DMA_StructInit(&DMA_InitStructure);
+    DMA_InitStructure.DMA_Priority = DMA_Priority_LOW;
+    DMA_InitStructure.DMA_CircularMode = DMA_CircularMode_Disable;
+    DMA_InitStructure.DMA_DataSize = DMA_DataSize_Byte;
+    DMA_InitStructure.DMA_TargetMode = DMA_TargetMode_FIXED;
+    DMA_InitStructure.DMA_SourceMode = DMA_SourceMode_INC;
+    DMA_InitStructure.DMA_Burst = DMA_Burst_Disable;
+    DMA_InitStructure.DMA_Request = Oled_Config.DMA_Request;
+    DMA_InitStructure.DMA_SrcAddress = (uint32_t)Oled_TxBuf[0];
+    DMA_InitStructure.DMA_DstAddress = (uint32_t)&Oled_Config.SPIx->SPI_DATA;
+    DMA_InitStructure.DMA_BufferSize = 0;
+    DMA_Init(Oled_Config.DMAx, &DMA_InitStructure);
+    DMA_ITConfig(Oled_Config.DMAx, DMA_IT_INTEN | DMA_IT_TCIE, ENABLE);
+
+    /* ȼADCжϿռʾж */
+    irq = (Oled_Config.DMAx == DMA0) ? DMA0_IRQn : DMA1_IRQn;
+    NVIC_SetPriority(irq, 3);
+    NVIC_EnableIRQ(irq);
+
+    /* Ӳλ */
+    GPIO_ResetBits(Oled_Config.CtrlGPIOx, Oled_Config.RstPin);
+    Oled_DelayUs(OLED_RESET_US);
+    GPIO_SetBits(Oled_Config.CtrlGPIOx, Oled_Config.RstPin);
+    Oled_DelayUs(OLED_RESET_US);
+
+    /* ʼзڵõOled_Flushͳ */
+    Oled_WriteCommands(Oled_InitSequence, sizeof(Oled_InitSequence), 0);
+    Oled_Clear();
+
+    MemMonitor_AddModule("oled", sizeof(Oled_Frame) + sizeof(Oled_TxBuf) + sizeof(Oled_CmdBuf) +
+                         sizeof(Oled_Dirty) + sizeof(Oled_Send));
+}
+
+/**
+  * @brief  򿪻رʾرպSSD1306˯ߣԴ汣֣
+  */
+void Oled_Cmd(FunctionalState NewState)
+{
+    uint8_t cmd = (NewState != DISABLE) ? OLED_CMD_DISPLAY_ON : OLED_CMD_DISPLAY_OFF;
+
+    while(Oled_DmaBusy) {}
+    Oled_WriteCommands(&cmd, 1, 0);
+}
+
+/**
+  * @brief  Դ棬ȫΪ
+  */
+void Oled_Clear(void)
+{
+    for(uint8_t page = 0; page < OLED_PAGES; page++) {
+        for(uint8_t x = 0; x < OLED_WIDTH; x++) {
+            Oled_Frame[page][x] = 0;
+        }
+    }
+    for(uint8_t i = 0; i < OLED_DIGITS; i++) {
+        Oled_ShownSegs[i] = 0;
+    }
+    Oled_ShownMinus = 0;
+    Oled_ShownUnit = OLED_UNIT_NONE;
+    Oled_ShownIcons = 0;
+
+    Oled_DirtyCount = 0;
+    Oled_MarkDirty(0, OLED_WIDTH - 1, 0, OLED_PAGES - 1);
+}
+
+/**
+  * @brief  ΣλأĻĲֲõ
+  * @param  on: 10Ϩ
+  */
+void Oled_FillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t on)
+{
+    uint8_t x1, y1, page0, page1;
+    uint8_t mask;
+
+    if(w == 0 || h == 0 || x >= OLED_WIDTH || y >= OLED_HEIGHT) return;
+    x1 = (x + w > OLED_WIDTH) ? (OLED_WIDTH - 1) : (uint8_t)(x + w - 1);
+    y1 = (y + h > OLED_HEIGHT) ? (OLED_HEIGHT - 1) : (uint8_t)(y + h - 1);
+    page0 = y >> 3;
+    page1 = y1 >> 3;
+
+    for(uint8_t page = page0; page <= page1; page++) {
+        /* ҳy..y1ǵλ */
+        mask = 0xFFU;
+        if(page == page0) mask &= (uint8_t)(0xFFU << (y & 7));
+        if(page == page1) mask &= (uint8_t)(0xFFU >> (7 - (y1 & 7)));
+        for(uint8_t col = x; col <= x1; col++) {
+            if(on) {
+                Oled_Frame[page][col] |= mask;
+            } else {
+                Oled_Frame[page][col] &= (uint8_t)~mask;
+            }
+        }
+    }
+    Oled_MarkDirty(x, x1, page0, page1);
+}
+
+/**
+  * @brief  һҳд5x7ַֿ֣ʾΪհף
+  */
+void Oled_DrawText(uint8_t x, uint8_t page, const char* text)
+{
+    const uint8_t* cols;
+    uint8_t start = x;
+
+    if(page >= OLED_PAGES) return;
+
+    for(; *text != '\0' && x + OLED_CHAR_W <= OLED_WIDTH; text++) {
+        cols = 0;
+        for(uint8_t i = 0; i < sizeof(Oled_Font) / sizeof(Oled_Font[0]); i++) {
+            if(Oled_Font[i].ch == *text) {
+                cols = Oled_Font[i].col;
+                break;
+            }
+        }
+        for(uint8_t i = 0; i < OLED_CHAR_W; i++) {
+            Oled_Frame[page][x++] = (cols != 0 && i < 5) ? cols[i] : 0;
+        }
+    }
+    if(x > start) Oled_MarkDirty(start, x - 1, page, page);
+}
+
+/**
+  * @brief  ʾֶȡ10kg°gʾ1λСϰkgʾ3λС
+  * @note   ֻػ롢Żλб仯ָȶʱ
+  */
+void Oled_ShowWeight(int32_t milligram, uint8_t step)
+{
+    uint8_t segs[OLED_DIGITS];
+    NumFormat_Unit unit;
+    uint8_t flags = NumFormat_Weight(milligram, step, segs, OLED_DIGITS, &unit);
+    uint8_t minus = (flags & (NUMFMT_NEGATIVE | NUMFMT_OVERFLOW)) == NUMFMT_NEGATIVE;
+    uint8_t unitCode = (flags & NUMFMT_OVERFLOW) ? OLED_UNIT_NONE : (uint8_t)unit;
+
+    for(uint8_t i = 0; i < OLED_DIGITS; i++) {
+        if(segs[i] != Oled_ShownSegs[i]) {
+            Oled_DrawDigit(i, segs[i]);
+            Oled_ShownSegs[i] = segs[i];
+        }
+    }
+
+    if(minus != Oled_ShownMinus) {
+        Oled_FillRect(OLED_MINUS_X, OLED_DIGIT_Y + Oled_Segments[6].y, OLED_MINUS_W, Oled_Segments[6].h, minus);
+        Oled_ShownMinus = minus;
+    }
+
+    if(unitCode != Oled_ShownUnit) {
+        Oled_FillRect(OLED_UNIT_X, OLED_UNIT_PAGE * 8, 2 * OLED_CHAR_W, 8, 0);
+        if(unitCode == NUMFMT_UNIT_G) {
+            Oled_DrawText(OLED_UNIT_X, OLED_UNIT_PAGE, "g");
+        } else if(unitCode == NUMFMT_UNIT_KG) {
+            Oled_DrawText(OLED_UNIT_X, OLED_UNIT_PAGE, "kg");
+        }
+        Oled_ShownUnit = unitCode;
+    }
+}
+
+/**
+  * @brief  ʾ״̬ǩ״̬ʱػ
+  */
+void Oled_SetIcon(Oled_Icon icon, uint8_t on)
+{
+    uint8_t bit;
+    uint8_t len = 0;
+
+    if(icon >= OLED_ICON_MAX) return;
+
+    bit = (uint8_t)(1U << icon);
+    if(((Oled_ShownIcons & bit) != 0) == (on != 0)) return;
+
+    if(on) {
+        Oled_ShownIcons |= bit;
+        Oled_DrawText(Oled_IconLabels[icon].x, 0, Oled_IconLabels[icon].text);
+    } else {
+        Oled_ShownIcons &= (uint8_t)~bit;
+        while(Oled_IconLabels[icon].text[len] != '\0') len++;
+        Oled_FillRect(Oled_IconLabels[icon].x, 0, len * OLED_CHAR_W, 8, 0);
+    }
+}
+
+/**
+  * @brief  Σһηʼһ
+  * @note   һŽµΣǰĻһ
+  */
+void Oled_Flush(void)
+{
+    if(Oled_DmaBusy) return;
+
+    if(Oled_SendIndex >= Oled_SendCount) {
+        if(Oled_DirtyCount == 0) return;
+        for(uint8_t i = 0; i < Oled_DirtyCount; i++) {
+            Oled_Send[i] = Oled_Dirty[i];
+        }
+        Oled_SendCount = Oled_DirtyCount;
+        Oled_SendIndex = 0;
+        Oled_DirtyCount = 0;
+    }
+    Oled_StartRect(&Oled_Send[Oled_SendIndex++]);
+}
+
+/**
+  * @brief  δͣ͹ǰ飩
+  */
+uint8_t Oled_IsBusy(void)
+{
+    return Oled_DmaBusy || Oled_SendIndex < Oled_SendCount || Oled_DirtyCount != 0;
+}
+
+/**
+  * @brief  ۼƷֽˢ¿
+  */
+uint32_t Oled_GetByteCount(void)
+{
+    return Oled_ByteCount;
+}
+
+/**
+  * @brief  DMAжϣָDCʼݣҳл׼õĻ壬
+  *         ͬʱ׼һҳ
+  */
+void Oled_DMAIRQHandler(void)
+{
+    if(DMA_GetFlagStatus(Oled_Config.DMAx, DMA_FLAG_TCIF) == RESET) return;
+    DMA_ClearFlag(Oled_Config.DMAx, DMA_FLAG_TCIF | DMA_FLAG_GIF);
+
+    if(Oled_CmdPhase) {
+        Oled_WaitSpiIdle();
+        GPIO_SetBits(Oled_Config.CtrlGPIOx, Oled_Config.DcPin);
+        Oled_CmdPhase = 0;
+        if(Oled_RectPending) {
+            Oled_RectPending = 0;
+            Oled_StartDma(Oled_TxBuf[0], Oled_TxLen[0]);
+        } else {
+            Oled_DmaBusy = 0;
+        }
+    } else if(Oled_TxReady) {
+        Oled_TxActive ^= 1;
+        Oled_StartDma(Oled_TxBuf[Oled_TxActive], Oled_TxLen[Oled_TxActive]);
+        Oled_TxReady = Oled_Stage(Oled_TxActive ^ 1);
+    } else {
+        /* һεĴDCһֽڷ */
+        Oled_WaitSpiIdle();
+        Oled_DmaBusy = 0;
+    }
+}
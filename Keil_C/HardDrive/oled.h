@@ -0,0 +1,61 @@
+//oled.h
+
+#ifndef __OLED_H
+#define __OLED_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_gpio.h"
+#include "sc32f1xxx_spi.h"
+#include "sc32f1xxx_dma.h"
+
+/** @defgroup ͼʾض
+  * @{
+  */
+#define OLED_WIDTH               128     // SSD1306 128x64ɫ
+#define OLED_HEIGHT              64
+#define OLED_PAGES               (OLED_HEIGHT / 8)   // ÿҳ8УԴһֽΪһ8
+#define OLED_MAX_DIRTY           4       // ޣʱϲ
+
+/** @}
+  */
+
+/* ״ָ̬ʾ0ҳֱǩ */
+typedef enum {
+    OLED_ICON_STABLE = 0,       // ȶ
+    OLED_ICON_ZERO,             // 
+    OLED_ICON_TARE,             // ȥƤ
+    OLED_ICON_OVERLOAD,         // 
+    OLED_ICON_MAX
+} Oled_Icon;
+
+/** @brief ͼʾýṹ壨4SPICSӵأ */
+typedef struct {
+    SPI_TypeDef* SPIx;           // SPIģ
+    uint32_t Prescaler;          // SPIƵSPI_Prescaler_TypeDef
+    DMA_TypeDef* DMAx;           // DMAͨDMA0/DMA1
+    uint32_t DMA_Request;        // DMAԴDMA_Request_SPIx_TX
+    GPIO_TypeDef* CtrlGPIOx;     // DCRSTڶ˿
+    uint16_t DcPin;              // /ѡ
+    uint16_t RstPin;             // λ
+} Oled_InitTypeDef;
+
+/* ʼͿ */
+void Oled_Init(Oled_InitTypeDef* Oled_InitStruct);
+void Oled_Cmd(FunctionalState NewState);
+
+/* ƵԴ棨SPI޸ĵΪ */
+void Oled_Clear(void);
+void Oled_FillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t on);
+void Oled_DrawText(uint8_t x, uint8_t page, const char* text);
+void Oled_ShowWeight(int32_t milligram, uint8_t step);
+void Oled_SetIcon(Oled_Icon icon, uint8_t on);
+
+/* ξDMAͣȴҪڵֱȫ */
+void Oled_Flush(void);
+uint8_t Oled_IsBusy(void);
+uint32_t Oled_GetByteCount(void);
+
+/* жϴҪSC_it.cDMAжеã */
+void Oled_DMAIRQHandler(void);
+
+#endif /* __OLED_H */
@@ -0,0 +1,133 @@
+//overload_trip.c
+
+#include "overload_trip.h"
+#include "weight_sensor.h"
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static OverloadTrip_InitTypeDef OverloadTrip_Handler;
+static OverloadTrip_Callback TripCallback = 0;
+static volatile uint8_t Tripped = 0;              // ӲѴ²
+static uint8_t LadderStep = 0;                    // ǰֵλ0ʾδ
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  رȽʼ˽˷شж
+  */
+void OverloadTrip_Init(OverloadTrip_InitTypeDef* OverloadTrip_InitStruct)
+{
+    CMP_InitTypeDef CMP_InitStructure;
+
+    /*  */
+    OverloadTrip_Handler.CMPx = OverloadTrip_InitStruct->CMPx;
+    OverloadTrip_Handler.SupplyVoltage = OverloadTrip_InitStruct->SupplyVoltage;
+
+    /* ñȽ */
+    CMP_StructInit(&CMP_InitStructure);
+    CMP_InitStructure.CMP_Positive = CMP_Positive_OP;          // ˣ˷
+    CMP_InitStructure.CMP_Negative = CMP_Negative_15D16VDD;    // 趨ֵǰߵ
+    CMP_InitStructure.CMP_TriggerMode = CMP_TriggerMode_RISE;  // ֵʱ
+    CMP_Init(OverloadTrip_Handler.CMPx, &CMP_InitStructure);
+
+    /* ֵ趨ʹܱȽ */
+    CMP_Cmd(OverloadTrip_Handler.CMPx, DISABLE);
+    CMP_ClearFlag(OverloadTrip_Handler.CMPx, CMP_FLAG_IF);
+    LadderStep = 0;
+    Tripped = 0;
+
+    NVIC_EnableIRQ(CMP_IRQn);
+}
+
+/**
+  * @brief  ADCֵ趨ֵ
+  * @param  count: صӦADCֵ
+  * @retval 1: 趨ѡȡڸüֵλ  0: ȽΧӲر
+  */
+uint8_t OverloadTrip_SetThresholdCount(uint32_t count)
+{
+    float volts = (float)count * WEIGHT_ADC_REF_VOLTAGE / WEIGHT_ADC_RESOLUTION;
+    float stepVolts = OverloadTrip_Handler.SupplyVoltage / OVERLOAD_TRIP_LADDER_STEPS;
+    uint32_t step = (uint32_t)(volts / stepVolts);
+
+    /* ȡ֤Ӳֻʱ */
+    if((float)step * stepVolts < volts) step++;
+    if(step == 0) step = 1;
+
+    CMP_Cmd(OverloadTrip_Handler.CMPx, DISABLE);
+
+    if(step >= OVERLOAD_TRIP_LADDER_STEPS) {
+        LadderStep = 0;
+        return 0;
+    }
+
+    CMP_SetNegativeChannel(OverloadTrip_Handler.CMPx, (CMP_Negative_TypeDef)(step << CMP_CFG_CMPRF_Pos));
+    CMP_ClearFlag(OverloadTrip_Handler.CMPx, CMP_FLAG_IF);
+    LadderStep = step;
+    CMP_Cmd(OverloadTrip_Handler.CMPx, ENABLE);
+    return 1;
+}
+
+/**
+  * @brief  ȡʵЧֵΪADCֵ
+  * @retval ֵֵδʱ0
+  */
+uint32_t OverloadTrip_GetThresholdCount(void)
+{
+    float volts = (float)LadderStep * OverloadTrip_Handler.SupplyVoltage / OVERLOAD_TRIP_LADDER_STEPS;
+    return (uint32_t)(volts * WEIGHT_ADC_RESOLUTION / WEIGHT_ADC_REF_VOLTAGE);
+}
+
+/**
+  * @brief  ùشص
+  */
+void OverloadTrip_SetCallback(OverloadTrip_Callback callback)
+{
+    TripCallback = callback;
+}
+
+/**
+  * @brief  ӲǷѴ
+  */
+uint8_t OverloadTrip_IsTripped(void)
+{
+    return Tripped;
+}
+
+/**
+  * @brief  ȽǰǷֵ
+  */
+uint8_t OverloadTrip_IsAboveThreshold(void)
+{
+    if(LadderStep == 0) return 0;
+    return (CMP_GetCMPSTA(OverloadTrip_Handler.CMPx) == CMP_CMPSTA_High);
+}
+
+/**
+  * @brief  ȷϹؽ²
+  */
+void OverloadTrip_Rearm(void)
+{
+    CMP_ClearFlag(OverloadTrip_Handler.CMPx, CMP_FLAG_IF);
+    Tripped = OverloadTrip_IsAboveThreshold();
+}
+
+/**
+  * @brief  ȽжϴҪSC_it.cеã
+  */
+void OverloadTrip_IRQHandler(void)
+{
+    if(CMP_GetFlagStatus(OverloadTrip_Handler.CMPx, CMP_FLAG_IF) == RESET) return;
+
+    CMP_ClearFlag(OverloadTrip_Handler.CMPx, CMP_FLAG_IF);
+
+    if(!Tripped) {
+        Tripped = 1;
+        if(TripCallback != 0) {
+            TripCallback();
+        }
+    }
+}
@@ -0,0 +1,40 @@
+//overload_trip.h
+
+#ifndef __OVERLOAD_TRIP_H
+#define __OVERLOAD_TRIP_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_cmp.h"
+
+/** @defgroup رȽض
+  * @{
+  */
+#define OVERLOAD_TRIP_LADDER_STEPS   16      // ȽֵΪ n/16 VDD
+
+/** @}
+  */
+
+/** @brief شصָ루CMPжеã */
+typedef void (*OverloadTrip_Callback)(void);
+
+/** @brief رȽýṹ */
+typedef struct {
+    CMP_TypeDef* CMPx;           // Ƚʵ
+    float SupplyVoltage;         // VDDѹ(V)ڻֵλ
+} OverloadTrip_InitTypeDef;
+
+/* ʼú */
+void OverloadTrip_Init(OverloadTrip_InitTypeDef* OverloadTrip_InitStruct);
+uint8_t OverloadTrip_SetThresholdCount(uint32_t count);
+uint32_t OverloadTrip_GetThresholdCount(void);
+void OverloadTrip_SetCallback(OverloadTrip_Callback callback);
+
+/* ״̬ */
+uint8_t OverloadTrip_IsTripped(void);
+uint8_t OverloadTrip_IsAboveThreshold(void);
+void OverloadTrip_Rearm(void);
+
+/* жϴҪSC_it.cеã */
+void OverloadTrip_IRQHandler(void);
+
+#endif /* __OVERLOAD_TRIP_H */
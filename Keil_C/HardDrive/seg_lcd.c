@@ -0,0 +1,219 @@
+//seg_lcd.c
+
+#include "seg_lcd.h"
+#include "mem_monitor.h"
+#include "num_format.h"
+
+/* λãSEGźCOM */
+#define SEGLCD_PIN(seg, com)     (uint8_t)(((seg) << 2) | (com))
+#define SEGLCD_PIN_SEG(pin)      ((pin) >> 2)
+#define SEGLCD_PIN_COM(pin)      ((pin) & 0x03U)
+
+/* ֣nλռSEG(4+2n)SEG(5+2n)ָʾSEG14/SEG15 */
+#define SEGLCD_DIGIT_SEG0        4
+#define SEGLCD_ICON_SEG          14
+#define SEGLCD_SEG_PINS          0x0000FFF0U     // SEG4-SEG15
+#define SEGLCD_COM_PINS          0x0000000FU     // COM0-COM3
+
+/** @defgroup ģ˽б
+  * @{
+  */
+static uint8_t SegLcd_Shadow[SEGLCD_RAM_SIZE];   // ӰԴ棬LCDʾRAMһһӦ
+static uint32_t SegLcd_Dirty = 0;                 // LCDʾRAMһµֽ
+static uint32_t SegLcd_WriteCount = 0;            // ۼдĴ
+
+/* λa..dpһλSEGϵλãSEGƫ0/1COM0-3 */
+static const uint8_t SegLcd_DigitPins[8] = {
+    SEGLCD_PIN(1, 0),   // a
+    SEGLCD_PIN(1, 1),   // b
+    SEGLCD_PIN(1, 2),   // c
+    SEGLCD_PIN(0, 3),   // d
+    SEGLCD_PIN(0, 2),   // e
+    SEGLCD_PIN(0, 0),   // f
+    SEGLCD_PIN(0, 1),   // g
+    SEGLCD_PIN(1, 3),   // dp
+};
+
+/* ָʾλ */
+static const uint8_t SegLcd_IconPins[SEGLCD_ICON_MAX] = {
+    SEGLCD_PIN(SEGLCD_ICON_SEG, 0),       // 
+    SEGLCD_PIN(SEGLCD_ICON_SEG, 1),       // g
+    SEGLCD_PIN(SEGLCD_ICON_SEG, 2),       // kg
+    SEGLCD_PIN(SEGLCD_ICON_SEG, 3),       // ȶ
+    SEGLCD_PIN(SEGLCD_ICON_SEG + 1, 0),   // 
+    SEGLCD_PIN(SEGLCD_ICON_SEG + 1, 1),   // ȥƤ
+    SEGLCD_PIN(SEGLCD_ICON_SEG + 1, 2),   // 
+};
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  ޸ӰԴеһֽڣб仯ʱΪ
+  */
+static void SegLcd_SetByte(uint8_t reg, uint8_t value)
+{
+    if(SegLcd_Shadow[reg] != value) {
+        SegLcd_Shadow[reg] = value;
+        SegLcd_Dirty |= (1UL << reg);
+    }
+}
+
+/**
+  * @brief  һλ֣λa..dpֶռSEGCOM0-3
+  */
+static void SegLcd_SetDigit(uint8_t position, uint8_t pattern)
+{
+    uint8_t lines[2] = { 0, 0 };
+    uint8_t seg = SEGLCD_DIGIT_SEG0 + position * 2;
+
+    for(uint8_t i = 0; i < 8; i++) {
+        if(pattern & (1U << i)) {
+            lines[SEGLCD_PIN_SEG(SegLcd_DigitPins[i])] |= (uint8_t)(1U << SEGLCD_PIN_COM(SegLcd_DigitPins[i]));
+        }
+    }
+    SegLcd_SetByte(seg, lines[0]);
+    SegLcd_SetByte(seg + 1, lines[1]);
+}
+
+/**
+  * @brief  NumFormatɵĶ͸
+  */
+static void SegLcd_ShowSegments(const uint8_t* segs, uint8_t flags)
+{
+    SegLcd_SetIcon(SEGLCD_ICON_MINUS, (flags & (NUMFMT_NEGATIVE | NUMFMT_OVERFLOW)) == NUMFMT_NEGATIVE);
+    for(uint8_t i = 0; i < SEGLCD_DIGITS; i++) {
+        SegLcd_SetDigit(i, segs[i]);
+    }
+}
+
+/**
+  * @brief  Һʼ1/4ռձȣCOM0-3SEG4-15ʾRAM
+  */
+void SegLcd_Init(SegLcd_InitTypeDef* SegLcd_InitStruct)
+{
+    LCD_InitTypeDef LCD_InitStructure;
+
+    LCD_StructInit(&LCD_InitStructure);
+    LCD_InitStructure.LCD_FrameFre = SegLcd_InitStruct->FrameFre;
+    LCD_InitStructure.LCD_Duty = LCD_Duty_1_4_SEG4_27COM0_3;
+    LCD_InitStructure.LCD_Bias = SegLcd_InitStruct->Bias;
+    LCD_InitStructure.LCD_Voltage = SegLcd_InitStruct->Voltage;
+    LCD_InitStructure.LCD_ComPin = SEGLCD_COM_PINS;
+    LCD_InitStructure.LCD_SegPin = SEGLCD_SEG_PINS;
+    LCD_Init(&LCD_InitStructure);
+
+    for(uint8_t i = 0; i < SEGLCD_RAM_SIZE; i++) {
+        SegLcd_Shadow[i] = 0;
+        LCD_Write((LCD_RAMRegister_Typedef)i, 0);
+    }
+    SegLcd_Dirty = 0;
+
+    LCD_Cmd(ENABLE);
+    MemMonitor_AddModule("seg_lcd", sizeof(SegLcd_Shadow));
+}
+
+/**
+  * @brief  򿪻رҺػʱرգ
+  */
+void SegLcd_Cmd(FunctionalState NewState)
+{
+    LCD_Cmd(NewState);
+}
+
+/**
+  * @brief  ӰԴ棨ֺȫָʾţ
+  */
+void SegLcd_Clear(void)
+{
+    for(uint8_t i = 0; i < SEGLCD_RAM_SIZE; i++) {
+        SegLcd_SetByte(i, 0);
+    }
+}
+
+/**
+  * @brief  ҶʾdecimalsλСǰλʾ
+  * @param  value: ʾֵѰСλŴʾ12.3ʱ1231
+  */
+void SegLcd_ShowNumber(int32_t value, uint8_t decimals)
+{
+    uint8_t segs[SEGLCD_DIGITS];
+
+    SegLcd_ShowSegments(segs, NumFormat_Segments(value, decimals, segs, SEGLCD_DIGITS));
+}
+
+/**
+  * @brief  ʾֶȡ10kg°gʾ1λСϰkgʾ3λС
+  * @param  milligram: (mg)
+  * @param  step: ֶϵ1/2/5gstep0.1gkgstep1g
+  */
+void SegLcd_ShowWeight(int32_t milligram, uint8_t step)
+{
+    uint8_t segs[SEGLCD_DIGITS];
+    NumFormat_Unit unit;
+    uint8_t flags = NumFormat_Weight(milligram, step, segs, SEGLCD_DIGITS, &unit);
+
+    SegLcd_ShowSegments(segs, flags);
+    SegLcd_SetIcon(SEGLCD_ICON_G, !(flags & NUMFMT_OVERFLOW) && unit == NUMFMT_UNIT_G);
+    SegLcd_SetIcon(SEGLCD_ICON_KG, !(flags & NUMFMT_OVERFLOW) && unit == NUMFMT_UNIT_KG);
+}
+
+/**
+  * @brief  ȫʾߣ̣
+  */
+void SegLcd_ShowDashes(void)
+{
+    SegLcd_SetIcon(SEGLCD_ICON_MINUS, 0);
+    for(uint8_t i = 0; i < SEGLCD_DIGITS; i++) {
+        SegLcd_SetDigit(i, NUMFMT_SEG_MINUS);
+    }
+}
+
+/**
+  * @brief  Ϩָʾ
+  */
+void SegLcd_SetIcon(SegLcd_Icon icon, uint8_t on)
+{
+    uint8_t pin, reg, value;
+
+    if(icon >= SEGLCD_ICON_MAX) return;
+
+    pin = SegLcd_IconPins[icon];
+    reg = SEGLCD_PIN_SEG(pin);
+    value = SegLcd_Shadow[reg];
+    if(on) {
+        value |= (uint8_t)(1U << SEGLCD_PIN_COM(pin));
+    } else {
+        value &= (uint8_t)~(1U << SEGLCD_PIN_COM(pin));
+    }
+    SegLcd_SetByte(reg, value);
+}
+
+/**
+  * @brief  ֻѱ仯ֽдLCDʾRAM
+  * @retval дļĴ
+  */
+uint8_t SegLcd_Flush(void)
+{
+    uint32_t dirty = SegLcd_Dirty;
+    uint8_t writes = 0;
+
+    SegLcd_Dirty = 0;
+    for(uint8_t i = 0; dirty != 0; i++, dirty >>= 1) {
+        if(dirty & 1U) {
+            LCD_Write((LCD_RAMRegister_Typedef)i, SegLcd_Shadow[i]);
+            writes++;
+        }
+    }
+    SegLcd_WriteCount += writes;
+    return writes;
+}
+
+/**
+  * @brief  ۼдĴˢ¿
+  */
+uint32_t SegLcd_GetWriteCount(void)
+{
+    return SegLcd_WriteCount;
+}
@@ -0,0 +1,52 @@
+//seg_lcd.h
+
+#ifndef __SEG_LCD_H
+#define __SEG_LCD_H
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_lcd.h"
+
+/** @defgroup Һض
+  * @{
+  */
+#define SEGLCD_DIGITS            5       // λ7+С㣩
+#define SEGLCD_RAM_SIZE          28      // LCD_RAMRegister_0..27ÿSEGһֽڣλnӦCOMn
+
+/** @}
+  */
+
+/* ָʾ */
+typedef enum {
+    SEGLCD_ICON_MINUS = 0,      // 
+    SEGLCD_ICON_G,              // λ g
+    SEGLCD_ICON_KG,             // λ kg
+    SEGLCD_ICON_STABLE,         // ȶ
+    SEGLCD_ICON_ZERO,           // 
+    SEGLCD_ICON_TARE,           // ȥƤ
+    SEGLCD_ICON_OVERLOAD,       // 
+    SEGLCD_ICON_MAX
+} SegLcd_Icon;
+
+/** @brief Һýṹ壨1/4ռձȣCOM0-3SEG4-15 */
+typedef struct {
+    uint16_t FrameFre;           // ֡ƵLCD_FrameFre_TypeDef
+    uint16_t Bias;               // ƫѹLCD_Bias_TypeDef
+    uint8_t Voltage;             // VLCD = VDD*(17+Voltage)/320-15
+} SegLcd_InitTypeDef;
+
+/* ʼͿ */
+void SegLcd_Init(SegLcd_InitTypeDef* SegLcd_InitStruct);
+void SegLcd_Cmd(FunctionalState NewState);
+
+/* ƵӰԴ棨LCDĴ */
+void SegLcd_Clear(void);
+void SegLcd_ShowNumber(int32_t value, uint8_t decimals);
+void SegLcd_ShowWeight(int32_t milligram, uint8_t step);
+void SegLcd_ShowDashes(void);
+void SegLcd_SetIcon(SegLcd_Icon icon, uint8_t on);
+
+/* ѱ仯ֽдLCDʾRAM */
+uint8_t SegLcd_Flush(void);
+uint32_t SegLcd_GetWriteCount(void);
+
+#endif /* __SEG_LCD_H */
@@ -9,6 +9,10 @@
  */
 
 #include "weight_sensor.h"
+#include "system_timer.h"
+#include "ram_code.h"
+#include "profiler.h"
+#include "mem_monitor.h"
 #include <string.h>
 
 /** @defgroup ģ˽б
@@ -27,6 +31,20 @@ static Weight_CalibTypeDef WeightCalib = {
 };
 
 static ADC_TypeDef* ADC_Instance = ADC;
+static OP_TypeDef* OP_Instance = OP;
+static uint32_t LastFiltered = 0;                         // һ˲ǰȶֵ
+static uint8_t FrontEndOn = 0;                            // ˷/ADCϵ磨ͻλͻ֮Ϊ0
+
+/* ģʽADCж */
+static volatile uint8_t ContinuousMode = 0;                // ʹܱ־
+static volatile uint8_t SampleReady = 0;                   // ²־
+static volatile uint16_t LastSample = 0;                   // жµĲֵ
+static WeightSensor_SampleCallback SampleCallback = 0;     // ص
+static uint32_t TimeoutCount = 0;                          // תʱ
+
+/* ֲУ׼ */
+static uint32_t CalibSum = 0;                              // У׼ۼӺ
+static uint16_t CalibCount = 0;                            // ѲɼУ׼
 
 /**
   * @}
@@ -49,12 +67,15 @@ void WeightSensor_Init(WeightSensor_InitTypeDef* WeightSensor_InitStruct)
 {
     /* ʵָ */
     ADC_Instance = WeightSensor_InitStruct->ADCx;
+    OP_Instance = WeightSensor_InitStruct->OPx;
+    MemMonitor_AddModule("weight_sensor", sizeof(SampleBuffer));
     
     /* ʼ˷ */
     WeightSensor_OPInit(WeightSensor_InitStruct->OPx, WeightSensor_InitStruct->OP_Gain);
     
     /* ʼADC */
     WeightSensor_ADCInit(WeightSensor_InitStruct->ADCx, WeightSensor_InitStruct->ADC_Channel);
+    FrontEndOn = 1;
     
     /* ղ */
     memset(SampleBuffer, 0, sizeof(SampleBuffer));
@@ -135,19 +156,52 @@ void WeightSensor_ADCInit(ADC_TypeDef* ADCx, uint32_t Channel)
   */
 uint16_t WeightSensor_ReadRawADC(void)
 {
+    Deadline_Ms timeout;
+    
+    Deadline_Start(&timeout, WEIGHT_ADC_TIMEOUT_MS);
+    
+    /* ģʽжתֻȡ² */
+    if(ContinuousMode) {
+        while(SampleReady == 0) {
+            // ȴһʱһβ
+            if(Deadline_IsExpired(&timeout)) {
+                TimeoutCount++;
+                return LastSample;
+            }
+        }
+        SampleReady = 0;
+        return LastSample;
+    }
+
     /* ADCת */
+    PROF_BEGIN(PROF_ADC_WAIT);
     ADC_SoftwareStartConv(ADC_Instance);
     
     /* ȴת */
     while(ADC_GetFlagStatus(ADC_Instance, ADC_Flag_ADCIF) == RESET) {
-        // ȴת
+        // ȴתɣʱһβ
+        if(Deadline_IsExpired(&timeout)) {
+            TimeoutCount++;
+            PROF_END(PROF_ADC_WAIT);
+            return LastSample;
+        }
     }
+    PROF_END(PROF_ADC_WAIT);
     
     /* ־λ */
     ADC_ClearFlag(ADC_Instance, ADC_Flag_ADCIF);
     
     /* ת */
-    return ADC_GetConversionValue(ADC_Instance);
+    LastSample = ADC_GetConversionValue(ADC_Instance);
+    return LastSample;
+}
+
+/**
+  * @brief  ȡADCתʱã
+  */
+uint32_t WeightSensor_GetTimeoutCount(void)
+{
+    return TimeoutCount;
 }
 
 /**
@@ -158,7 +212,11 @@ uint16_t WeightSensor_ReadRawADC(void)
 uint32_t WeightSensor_SlidingWindowFilter(void)
 {
     uint16_t newSample = WeightSensor_ReadRawADC();
-    return CalculateMovingAverage(newSample);
+    uint32_t filtered;
+    PROF_BEGIN(PROF_FILTER);
+    filtered = CalculateMovingAverage(newSample);
+    PROF_END(PROF_FILTER);
+    return filtered;
 }
 
 /**
@@ -188,10 +246,137 @@ static uint32_t CalculateMovingAverage(uint16_t newSample)
     
     /* ƽֵ */
     if(BufferFilled) {
-        return RunningSum / WEIGHT_SAMPLE_BUFFER_SIZE;
+        LastFiltered = RunningSum / WEIGHT_SAMPLE_BUFFER_SIZE;
+    } else {
+        LastFiltered = RunningSum / (SampleIndex + 1);
+    }
+    return LastFiltered;
+}
+
+/**
+  * @brief  ֵָڣ˽к˲Ч
+  */
+static void SeedMovingAverage(uint16_t value)
+{
+    for(uint16_t i = 0; i < WEIGHT_SAMPLE_BUFFER_SIZE; i++) {
+        SampleBuffer[i] = value;
+    }
+    RunningSum = (uint32_t)value * WEIGHT_SAMPLE_BUFFER_SIZE;
+    SampleIndex = 0;
+    BufferFilled = 1;
+    LastFiltered = value;
+}
+
+/**
+  * @brief  ˷ϵ粢ȴʹADCڼת˽к
+  */
+static void FrontEndPowerOn(uint32_t settleUs)
+{
+    Time_Us start;
+
+    OP_Cmd(OP_Instance, ENABLE);
+    start = Time_NowUs();
+    while(Time_ElapsedUs(start) < settleUs) {
+        // ȴ˷Ž
+    }
+    ADC_Cmd(ADC_Instance, ENABLE);
+
+    for(uint8_t i = 0; i < WEIGHT_BURST_DISCARD; i++) {
+        (void)WeightSensor_ReadRawADC();
+    }
+}
+
+/**
+  * @brief  رADC˷ţ˽к
+  */
+static void FrontEndPowerOff(void)
+{
+    ADC_Cmd(ADC_Instance, DISABLE);
+    OP_Cmd(OP_Instance, DISABLE);
+}
+
+/**
+  * @brief  ȡ˲ļֵ˽к
+  * @note   ˷/ADCϵʱͻλReadRawADCֻᳬʱؾɲΪһͻ
+  */
+static uint32_t ReadFilteredCount(void)
+{
+    if(FrontEndOn) {
+        return WeightSensor_SlidingWindowFilter();
+    }
+    return WeightSensor_ReadBurst(WEIGHT_TARE_SAMPLES, WEIGHT_FRONTEND_SETTLE_US);
+}
+
+/**
+  * @brief  ǰر˷źADC
+  */
+void WeightSensor_PowerDown(void)
+{
+    WeightSensor_StopContinuous();
+    FrontEndPowerOff();
+    FrontEndOn = 0;
+}
+
+/**
+  * @brief  Ѻָ˷źADC˲
+  * @note   ˷ŽADCڼתֻɼδʱôǰȶֵ
+  *         ʾ仯ʱֵڣǵȴ
+  */
+void WeightSensor_PowerUp(void)
+{
+    uint32_t sum = 0;
+    uint32_t average;
+
+    FrontEndPowerOn(WEIGHT_FRONTEND_SETTLE_US);
+    FrontEndOn = 1;
+
+    for(uint8_t i = 0; i < WEIGHT_RESTART_SAMPLES; i++) {
+        sum += WeightSensor_ReadRawADC();
+    }
+    average = sum / WEIGHT_RESTART_SAMPLES;
+
+    if(BufferFilled &&
+       average + WEIGHT_RESTART_BAND >= LastFiltered &&
+       average <= LastFiltered + WEIGHT_RESTART_BAND) {
+        SeedMovingAverage((uint16_t)LastFiltered);
+    } else {
+        SeedMovingAverage((uint16_t)average);
+    }
+}
+
+/**
+  * @brief  ͻϵ˷źADCɼһϵ
+  * @param  samples: ЧĽ
+  * @param  settleUs: ˷ϵĽʱ(us)
+  * @retval ȥСֵƽֵ
+  */
+uint32_t WeightSensor_ReadBurst(uint8_t samples, uint32_t settleUs)
+{
+    uint32_t sum = 0;
+    uint16_t sample, minSample = 0xFFFF, maxSample = 0;
+
+    if(samples == 0) samples = 1;
+
+    /* ˷ϵ粢ȴADCڼת */
+    FrontEndPowerOn(settleUs);
+
+    for(uint8_t i = 0; i < samples; i++) {
+        sample = WeightSensor_ReadRawADC();
+        sum += sample;
+        if(sample < minSample) minSample = sample;
+        if(sample > maxSample) maxSample = sample;
+    }
+
+    /* ɼϵ */
+    FrontEndPowerOff();
+
+    /* 㹻ʱ޳ֵƵ */
+    if(samples > 2) {
+        LastFiltered = (sum - minSample - maxSample) / (samples - 2);
     } else {
-        return RunningSum / (SampleIndex + 1);
+        LastFiltered = sum / samples;
     }
+    return LastFiltered;
 }
 
 /**
@@ -209,29 +394,71 @@ float WeightSensor_GetVoltage(void)
   * @brief  ȥƤܣ㣩
   * @param  
   * @retval 
+  * @note   ͻλ˷/ADCڶϵ״̬ʱϵһͻ
   */
 void WeightSensor_Tare(void)
 {
-    WeightCalib.TareValue = WeightSensor_SlidingWindowFilter();
+    WeightCalib.TareValue = ReadFilteredCount();
+}
+
+/**
+  * @brief  ǷȥƤ״̬ȥƤֵ㣩
+  */
+uint8_t WeightSensor_IsTared(void)
+{
+    return WeightCalib.TareValue != WeightCalib.ZeroPoint;
 }
 
 /**
-  * @brief  У׼
+  * @brief  У׼һβɼȫʼʱʹã
   * @param  
   * @retval 
   */
 void WeightSensor_CalibrateZero(void)
 {
+    WeightSensor_CalibrateZeroBegin();
+    (void)WeightSensor_CalibrateZeroStep(WEIGHT_CALIB_SAMPLES);
+}
+
+/**
+  * @brief  ʼֲУ׼ۼӵ
+  */
+void WeightSensor_CalibrateZeroBegin(void)
+{
+    CalibSum = 0;
+    CalibCount = 0;
+}
+
+/**
+  * @brief  ֲУ׼ÿֻɼеò᳤ʱ
+  * @param  samples: ɼ
+  * @retval 1: ѲWEIGHT_CALIB_SAMPLESȥƤֵѸ  0: ɼ
+  */
+uint8_t WeightSensor_CalibrateZeroStep(uint16_t samples)
+{
+    uint8_t powered = 0;
+    
+    /* ͻλ˷/ADCϵ磬βɼڼʱϵ */
+    if(!FrontEndOn && CalibCount < WEIGHT_CALIB_SAMPLES) {
+        FrontEndPowerOn(WEIGHT_FRONTEND_SETTLE_US);
+        powered = 1;
+    }
+    
     /* ɼƽΪ */
-    uint32_t sum = 0;
-    uint16_t samples = 100;
+    while(samples > 0 && CalibCount < WEIGHT_CALIB_SAMPLES) {
+        CalibSum += WeightSensor_ReadRawADC();
+        CalibCount++;
+        samples--;
+    }
     
-    for(uint16_t i = 0; i < samples; i++) {
-        sum += WeightSensor_ReadRawADC();
+    if(powered) {
+        FrontEndPowerOff();
     }
+    if(CalibCount < WEIGHT_CALIB_SAMPLES) return 0;
     
-    WeightCalib.ZeroPoint = sum / samples;
+    WeightCalib.ZeroPoint = CalibSum / WEIGHT_CALIB_SAMPLES;
     WeightCalib.TareValue = WeightCalib.ZeroPoint;  // ͬʱȥƤֵ
+    return 1;
 }
 
 /**
@@ -244,7 +471,7 @@ void WeightSensor_CalibrateFullScale(uint32_t knownWeight)
     if(knownWeight == 0) return;
     
     /* ȡǰADCֵѷ֪ */
-    uint32_t currentADC = WeightSensor_SlidingWindowFilter();
+    uint32_t currentADC = ReadFilteredCount();
     
     /* ЧADCֵ */
     uint32_t effectiveADC = currentADC - WeightCalib.ZeroPoint;
@@ -263,10 +490,18 @@ void WeightSensor_CalibrateFullScale(uint32_t knownWeight)
   */
 float WeightSensor_GetWeightGram(void)
 {
-    uint32_t currentADC = WeightSensor_SlidingWindowFilter();
-    
+    return WeightSensor_CountToGram(WeightSensor_SlidingWindowFilter());
+}
+
+/**
+  * @brief  ADCֵתΪأˣ
+  * @param  count: ADCֵ
+  * @retval ֵ(g)ȥƤֵʱ0
+  */
+float WeightSensor_CountToGram(uint32_t count)
+{
     /* ȥȥƤֵ */
-    int32_t netADC = currentADC - WeightCalib.TareValue;
+    int32_t netADC = count - WeightCalib.TareValue;
     
     if(netADC <= 0) return 0.0f;
     
@@ -274,6 +509,18 @@ float WeightSensor_GetWeightGram(void)
     return (float)netADC * WeightCalib.ScaleFactor;
 }
 
+/**
+  * @brief  أˣתΪADCֵ
+  * @param  gram: (g)
+  * @retval ӦADCֵȥƤֵڲжȽ
+  */
+uint32_t WeightSensor_GramToCount(float gram)
+{
+    if(gram <= 0.0f) return WeightCalib.TareValue;
+    
+    return WeightCalib.TareValue + (uint32_t)(gram / WeightCalib.ScaleFactor + 0.5f);
+}
+
 /**
   * @brief  ȡԭʼֵ
   * @param  
@@ -303,3 +550,75 @@ void WeightSensor_StartConversion(void)
 {
     ADC_SoftwareStartConv(ADC_Instance);
 }
+
+/**
+  * @brief  òص
+  * @param  callback: ÿADCתɺжеã豣ִʱȷ
+  * @retval 
+  */
+void WeightSensor_SetSampleCallback(WeightSensor_SampleCallback callback)
+{
+    SampleCallback = callback;
+}
+
+/**
+  * @brief  ADCת + תжϣ
+  * @param  
+  * @retval 
+  */
+void WeightSensor_StartContinuous(void)
+{
+    if(ContinuousMode) return;
+    
+    SampleReady = 0;
+    ContinuousMode = 1;
+    
+    /* ͹Ĳʱ˷źADCܴڶϵ״̬ */
+    OP_Cmd(OP_Instance, ENABLE);
+    ADC_Cmd(ADC_Instance, ENABLE);
+    
+    ADC_ClearFlag(ADC_Instance, ADC_Flag_ADCIF);
+    ADC_ConvModeConfig(ADC_Instance, ADC_ConvMode_Continuous);
+    NVIC_EnableIRQ(ADC_IRQn);
+    ADC_SoftwareStartConv(ADC_Instance);
+}
+
+/**
+  * @brief  ָֹͣתģʽ
+  * @param  
+  * @retval 
+  */
+void WeightSensor_StopContinuous(void)
+{
+    if(!ContinuousMode) return;
+    
+    NVIC_DisableIRQ(ADC_IRQn);
+    ADC_ConvModeConfig(ADC_Instance, ADC_ConvMode_Single);
+    ADC_ClearFlag(ADC_Instance, ADC_Flag_ADCIF);
+    
+    ContinuousMode = 0;
+    SampleReady = 0;
+}
+
+/**
+  * @brief  ADCתжϴҪSC_it.cеã
+  * @param  
+  * @retval 
+  */
+RAM_FUNC void WeightSensor_ADC_IRQHandler(void)
+{
+    if(ADC_GetFlagStatus(ADC_Instance, ADC_Flag_ADCIF) == RESET) return;
+    
+    /* ־λ */
+    ADC_ClearFlag(ADC_Instance, ADC_Flag_ADCIF);
+    
+    /* ²ѭ˲ʹ */
+    uint16_t sample = ADC_GetConversionValue(ADC_Instance);
+    LastSample = sample;
+    SampleReady = 1;
+    
+    /* ·ص綨װֹжϣ */
+    if(SampleCallback != 0) {
+        SampleCallback(sample);
+    }
+}
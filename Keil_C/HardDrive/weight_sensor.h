@@ -24,9 +24,17 @@ extern "C" {
 /** @defgroup ض
   * @{
   */
-#define WEIGHT_SAMPLE_BUFFER_SIZE    1024    // ڴС
+#define WEIGHT_SAMPLE_BUFFER_SIZE    32      // ڴС״̬ÿ20msһΣԼ0.64s
 #define WEIGHT_ADC_REF_VOLTAGE      2.048f  // ADCοѹ2.048V
 #define WEIGHT_ADC_RESOLUTION       16384   // 14λADCֱ(2^14)
+#define WEIGHT_ADC_TIMEOUT_MS       5       // ת/ȴʱ(ms)
+#define WEIGHT_RESTART_SAMPLES      16      // Ѻ˲Ĳ
+#define WEIGHT_RESTART_BAND         8       // ǰȶֵڴ˷Χþֵ(count)
+#define WEIGHT_BURST_DISCARD        2       // ͻʼʱתADC
+#define WEIGHT_CALIB_SAMPLES        100     // У׼
+#define WEIGHT_CALIB_STEP_SAMPLES   10      // ֲУ׼ʱÿεòɼ
+#define WEIGHT_FRONTEND_SETTLE_US   500     // ˷ŶϵϵĽʱ(us)ѡʱϵ
+#define WEIGHT_TARE_SAMPLES         16      // ϵ״̬ȥƤ/У׼ͻ
 
 /** @defgroup У׼
   * @{
@@ -57,6 +65,9 @@ typedef struct {
   * @}
   */
 
+/** @brief صָ루ADCжеãΪԭʼADCֵ */
+typedef void (*WeightSensor_SampleCallback)(uint16_t rawSample);
+
 /** @defgroup 
   * @{
   */
@@ -68,22 +79,39 @@ void WeightSensor_ADCInit(ADC_TypeDef* ADCx, uint32_t Channel);
 
 /* ˲ */
 uint16_t WeightSensor_ReadRawADC(void);
+uint32_t WeightSensor_GetTimeoutCount(void);
 uint32_t WeightSensor_SlidingWindowFilter(void);
 float WeightSensor_GetVoltage(void);
 
 /* У׼ */
 void WeightSensor_Tare(void);
+uint8_t WeightSensor_IsTared(void);
 void WeightSensor_CalibrateZero(void);
+void WeightSensor_CalibrateZeroBegin(void);
+uint8_t WeightSensor_CalibrateZeroStep(uint16_t samples);
 void WeightSensor_CalibrateFullScale(uint32_t knownWeight);
 
 /* ȡ */
 float WeightSensor_GetWeightGram(void);
 uint32_t WeightSensor_GetWeightCount(void);
+float WeightSensor_CountToGram(uint32_t count);
+uint32_t WeightSensor_GramToCount(float gram);
 
 /* ״̬ */
 FlagStatus WeightSensor_IsDataReady(void);
 void WeightSensor_StartConversion(void);
 
+/* ж */
+void WeightSensor_SetSampleCallback(WeightSensor_SampleCallback callback);
+void WeightSensor_StartContinuous(void);
+void WeightSensor_StopContinuous(void);
+void WeightSensor_ADC_IRQHandler(void);
+
+/* ͹ĺ */
+void WeightSensor_PowerDown(void);
+void WeightSensor_PowerUp(void);
+uint32_t WeightSensor_ReadBurst(uint8_t samples, uint32_t settleUs);
+
 /**
   * @}
   */
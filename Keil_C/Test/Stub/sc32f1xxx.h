@@ -0,0 +1,71 @@
+//sc32f1xxx.h׮
+
+#ifndef __SC32F1XXX_H
+#define __SC32F1XXX_H
+
+/*
+ * õоƬͷļֻṩģõ͡ں˼ĴжϿƣ
+ * ĴͨɲԴֱӶдģʱӡжϵȣ
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum { RESET = 0, SET = !RESET } FlagStatus, ITStatus;
+typedef enum { DISABLE = 0, ENABLE = !DISABLE } FunctionalState;
+
+/* SysTick */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+/* SCBֻõICSR */
+typedef struct {
+    volatile uint32_t CPUID;
+    volatile uint32_t ICSR;
+} SCB_Type;
+
+#define SCB_ICSR_PENDSTSET_Pos       26U
+#define SCB_ICSR_PENDSTSET_Msk       (1UL << SCB_ICSR_PENDSTSET_Pos)
+#define SysTick_LOAD_RELOAD_Msk      0x00FFFFFFUL
+
+extern SysTick_Type Stub_SysTick;
+extern SCB_Type Stub_SCB;
+extern uint32_t Stub_Primask;
+
+#define SysTick                      (&Stub_SysTick)
+#define SCB                          (&Stub_SCB)
+
+/* жϺţֻNVIC_xxxõĲ */
+typedef enum {
+    SysTick_IRQn = -1,
+    BTM_IRQn = 0,
+    ADC_IRQn,
+    DMA0_IRQn
+} IRQn_Type;
+
+/* PRIMASKжֻλԵ߳ */
+static inline uint32_t __get_PRIMASK(void) { return Stub_Primask; }
+static inline void __set_PRIMASK(uint32_t primask) { Stub_Primask = primask; }
+static inline void __disable_irq(void) { Stub_Primask = 1; }
+static inline void __enable_irq(void) { Stub_Primask = 0; }
+static inline void __WFI(void) { }
+static inline void __NOP(void) { }
+static inline void __DMB(void) { }
+static inline void NVIC_EnableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+static inline void NVIC_DisableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+
+/* ʵֻʹָ룩 */
+typedef struct { uint32_t Reserved; } PWM_TypeDef;
+typedef struct { uint32_t Reserved; } GPIO_TypeDef;
+typedef struct { uint32_t Reserved; } BTM_TypeDef;
+
+extern PWM_TypeDef Stub_PWM0;
+extern BTM_TypeDef Stub_BTM;
+
+#define PWM0                         (&Stub_PWM0)
+#define BTM                          (&Stub_BTM)
+
+#endif /* __SC32F1XXX_H */
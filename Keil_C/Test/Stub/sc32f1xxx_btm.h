@@ -0,0 +1,8 @@
+//sc32f1xxx_btm.h׮
+
+#ifndef __SC32F1XXX_BTM_H
+#define __SC32F1XXX_BTM_H
+
+#include "sc32f1xxx.h"
+
+#endif /* __SC32F1XXX_BTM_H */
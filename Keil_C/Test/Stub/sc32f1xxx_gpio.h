@@ -0,0 +1,8 @@
+//sc32f1xxx_gpio.h׮
+
+#ifndef __SC32F1XXX_GPIO_H
+#define __SC32F1XXX_GPIO_H
+
+#include "sc32f1xxx.h"
+
+#endif /* __SC32F1XXX_GPIO_H */
@@ -0,0 +1,45 @@
+//sc32f1xxx_pwm.h׮
+
+#ifndef __SC32F1XXX_PWM_H
+#define __SC32F1XXX_PWM_H
+
+#include "sc32f1xxx.h"
+
+typedef enum { PWM_PRESCALER_DIV1 = 0 } PWM_Prescaler_TypeDef;
+typedef enum { PWM_AlignmentMode_Edge = 0 } PWM_AlignedMode_TypeDef;
+typedef enum { PWM_WorkMode_Independent = 0 } PWM_WorkMode_TypeDef;
+typedef enum {
+    PWMChannel_Less = 0x00000000,
+    PWM_Channel_0 = 0x00000001
+} PWM_Channel_Typedef;
+
+typedef struct {
+    uint16_t PWM_Prescaler;
+    uint16_t PWM_AlignedMode;
+    uint16_t PWM_WorkMode;
+    uint16_t PWM_Cycle;
+    uint32_t PWM_OutputChannel;
+    uint32_t PWM_LowPolarityChannl;
+} PWM_InitTypeDef;
+
+/* ģPWMһõڡռձȺʹ״̬ */
+typedef struct {
+    uint32_t Cycle;
+    uint16_t Duty;
+    uint8_t Enabled;
+    uint32_t EnableCount;          // DISABLE->ENABLEĴأ
+    uint32_t DisableCount;         // ENABLE->DISABLEĴأ
+} Stub_PwmStateTypeDef;
+
+extern Stub_PwmStateTypeDef Stub_Pwm;
+
+/* ÿʹ״̬仯ʱõĲԻصΪ0ʱ */
+extern void (*Stub_PwmEdgeHook)(uint8_t enabled);
+
+void PWM_StructInit(PWM_InitTypeDef* PWM_InitStruct);
+void PWM_Init(PWM_TypeDef* PWMx, PWM_InitTypeDef* PWM_InitStruct);
+void PWM_Cmd(PWM_TypeDef* PWMx, FunctionalState NewState);
+void PWM_SetCycle(PWM_TypeDef* PWMx, uint32_t PWM_Cycle);
+void PWM_SetDuty(PWM_TypeDef* PWMx, PWM_Channel_Typedef PWM_Channel, uint16_t PWM_Duty);
+
+#endif /* __SC32F1XXX_PWM_H */
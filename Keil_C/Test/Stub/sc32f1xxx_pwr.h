@@ -0,0 +1,26 @@
+//sc32f1xxx_pwr.h׮
+
+#ifndef __SC32F1XXX_PWR_H
+#define __SC32F1XXX_PWR_H
+
+#include "sc32f1xxx.h"
+
+typedef enum {
+    PWR_IDLEEntry_WFI = 0x01,
+    PWR_IDLEEntry_WFE = 0x02
+} PWR_IDLEEntry_TypeDef;
+
+typedef enum {
+    PWR_STOPEntry_WFI = 0x01,
+    PWR_STOPEntry_WFE = 0x02
+} PWR_STOPEntry_TypeDef;
+
+/* ʱõĲԻصģڼʱźжϵΪ0ʱֱӷ */
+extern void (*Stub_SleepHook)(void);
+extern uint32_t Stub_IdleCount;
+extern uint32_t Stub_StopCount;
+
+void PWR_EnterIDLEMode(uint8_t PWR_IDLEEntry);
+void PWR_EnterSTOPMode(uint8_t PWR_STOPEntry);
+
+#endif /* __SC32F1XXX_PWR_H */
@@ -0,0 +1,22 @@
+//sc32f1xxx_rcc.h׮
+
+#ifndef __SC32F1XXX_RCC_H
+#define __SC32F1XXX_RCC_H
+
+#include "sc32f1xxx.h"
+
+typedef struct {
+    uint32_t SYSCLK_Frequency;
+    uint32_t HCLK_Frequency;
+    uint32_t PCLK0_Frequency;
+    uint32_t PCLK1_Frequency;
+    uint32_t PCLK2_Frequency;
+} RCC_ClocksTypeDef;
+
+/* Կ޸ĵʱƵʣRCC_GetClocksFreq */
+extern RCC_ClocksTypeDef Stub_Clocks;
+
+void RCC_GetClocksFreq(RCC_ClocksTypeDef* RCC_Clocks);
+void RCC_SystickSetCounter(uint32_t Counter);
+
+#endif /* __SC32F1XXX_RCC_H */
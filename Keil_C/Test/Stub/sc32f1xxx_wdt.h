@@ -0,0 +1,12 @@
+//sc32f1xxx_wdt.h׮
+
+#ifndef __SC32F1XXX_WDT_H
+#define __SC32F1XXX_WDT_H
+
+#include "sc32f1xxx.h"
+
+typedef enum {
+    WDT_OverTime_500MS = 0
+} WDT_OverTime_TypeDef;
+
+#endif /* __SC32F1XXX_WDT_H */
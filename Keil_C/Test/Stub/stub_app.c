@@ -0,0 +1,29 @@
+//stub_app.c׮ģӦòǼǺ
+
+#include "mem_monitor.h"
+#include "supervisor.h"
+
+/* ڴ汨ͿŹ໤û壬ֻӿ */
+void MemMonitor_AddModule(const char* name, uint32_t bytes)
+{
+    (void)name;
+    (void)bytes;
+}
+
+int8_t Supervisor_Register(const char* name, uint32_t deadlineMs)
+{
+    (void)name;
+    (void)deadlineMs;
+    return 0;
+}
+
+void Supervisor_CheckIn(int8_t id)
+{
+    (void)id;
+}
+
+void Supervisor_HeartbeatCmd(int8_t id, FunctionalState NewState)
+{
+    (void)id;
+    (void)NewState;
+}
@@ -0,0 +1,102 @@
+//stub_hal.c׮ں˼Ĵ͹̼⺯
+
+#include "sc32f1xxx.h"
+#include "sc32f1xxx_rcc.h"
+#include "sc32f1xxx_pwr.h"
+#include "sc32f1xxx_pwm.h"
+
+/** @defgroup ģĴ״̬
+  * @{
+  */
+SysTick_Type Stub_SysTick;
+SCB_Type Stub_SCB;
+uint32_t Stub_Primask = 0;
+PWM_TypeDef Stub_PWM0;
+BTM_TypeDef Stub_BTM;
+
+RCC_ClocksTypeDef Stub_Clocks = { 64000000, 64000000, 64000000, 64000000, 64000000 };
+
+void (*Stub_SleepHook)(void) = 0;
+uint32_t Stub_IdleCount = 0;
+uint32_t Stub_StopCount = 0;
+
+Stub_PwmStateTypeDef Stub_Pwm;
+void (*Stub_PwmEdgeHook)(uint8_t enabled) = 0;
+
+/**
+  * @}
+  */
+
+void RCC_GetClocksFreq(RCC_ClocksTypeDef* RCC_Clocks)
+{
+    *RCC_Clocks = Stub_Clocks;
+}
+
+void RCC_SystickSetCounter(uint32_t Counter)
+{
+    if((Counter - 1UL) <= SysTick_LOAD_RELOAD_Msk) {
+        SysTick->LOAD = Counter - 1UL;
+        SysTick->VAL = 0;
+    }
+}
+
+/**
+  * @brief  ߣɲԻصƽģʱӻͶжϣȻ""
+  */
+void PWR_EnterIDLEMode(uint8_t PWR_IDLEEntry)
+{
+    (void)PWR_IDLEEntry;
+    Stub_IdleCount++;
+    if(Stub_SleepHook != 0) Stub_SleepHook();
+}
+
+void PWR_EnterSTOPMode(uint8_t PWR_STOPEntry)
+{
+    (void)PWR_STOPEntry;
+    Stub_StopCount++;
+    if(Stub_SleepHook != 0) Stub_SleepHook();
+}
+
+void PWM_StructInit(PWM_InitTypeDef* PWM_InitStruct)
+{
+    PWM_InitStruct->PWM_Prescaler = PWM_PRESCALER_DIV1;
+    PWM_InitStruct->PWM_AlignedMode = PWM_AlignmentMode_Edge;
+    PWM_InitStruct->PWM_WorkMode = PWM_WorkMode_Independent;
+    PWM_InitStruct->PWM_Cycle = 0;
+    PWM_InitStruct->PWM_OutputChannel = PWMChannel_Less;
+    PWM_InitStruct->PWM_LowPolarityChannl = PWMChannel_Less;
+}
+
+void PWM_Init(PWM_TypeDef* PWMx, PWM_InitTypeDef* PWM_InitStruct)
+{
+    (void)PWMx;
+    Stub_Pwm.Cycle = PWM_InitStruct->PWM_Cycle;
+}
+
+void PWM_Cmd(PWM_TypeDef* PWMx, FunctionalState NewState)
+{
+    uint8_t enabled = (NewState != DISABLE);
+
+    (void)PWMx;
+    if(enabled == Stub_Pwm.Enabled) return;
+    Stub_Pwm.Enabled = enabled;
+    if(enabled) {
+        Stub_Pwm.EnableCount++;
+    } else {
+        Stub_Pwm.DisableCount++;
+    }
+    if(Stub_PwmEdgeHook != 0) Stub_PwmEdgeHook(enabled);
+}
+
+void PWM_SetCycle(PWM_TypeDef* PWMx, uint32_t PWM_Cycle)
+{
+    (void)PWMx;
+    Stub_Pwm.Cycle = PWM_Cycle;
+}
+
+void PWM_SetDuty(PWM_TypeDef* PWMx, PWM_Channel_Typedef PWM_Channel, uint16_t PWM_Duty)
+{
+    (void)PWMx;
+    (void)PWM_Channel;
+    Stub_Pwm.Duty = PWM_Duty;
+}
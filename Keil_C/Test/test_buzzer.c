@@ -0,0 +1,231 @@
+//test_buzzer.c
+
+/*
+ * ԣBuzzer_TimerHandler
+ * ͨPWM׮¼ʹغڼ鷢/ʱ䡢ͬȼ˳ͱռ
+ */
+#include "unit_test.h"
+#include "buzzer.h"
+
+#define EDGE_LOG_SIZE   32
+
+/** @defgroup ģʱPWMؼ¼
+  * @{
+  */
+static uint32_t Ticks = 0;                  // ƽms
+static uint32_t EdgeTick[EDGE_LOG_SIZE];
+static uint8_t EdgeOn[EDGE_LOG_SIZE];       // 1:   0: 
+static uint32_t EdgeCycle[EDGE_LOG_SIZE];   // ʱPWM
+static uint32_t EdgeCount = 0;
+
+/**
+  * @}
+  */
+
+static void Edge_Record(uint8_t enabled)
+{
+    if(EdgeCount < EDGE_LOG_SIZE) {
+        EdgeTick[EdgeCount] = Ticks;
+        EdgeOn[EdgeCount] = enabled;
+        EdgeCycle[EdgeCount] = Stub_Pwm.Cycle;
+        EdgeCount++;
+    }
+}
+
+static void TickMs(uint32_t ms)
+{
+    while(ms-- > 0) {
+        Ticks++;
+        Buzzer_TimerHandler();
+    }
+}
+
+/**
+  * @brief  app_init.cͬãPWM0ͨ04kHz50%
+  */
+static void Setup(void)
+{
+    Buzzer_InitTypeDef Buzzer_InitStruct;
+
+    Buzzer_InitStruct.PWMx = PWM0;
+    Buzzer_InitStruct.Channel = PWM_Channel_0;
+    Buzzer_InitStruct.Frequency = 4000;
+    Buzzer_InitStruct.DutyCycle = 50;
+    Buzzer_Init(&Buzzer_InitStruct);
+    Stub_PwmEdgeHook = Edge_Record;
+}
+
+/* 64MHz PCLK0¸ƵʵPWM */
+#define CYCLE_OF(freq)   (64000000UL / (freq))
+
+/**
+  * @brief  ʱdurationĺ
+  */
+static void Case_BeepEdges(void)
+{
+    Setup();
+    Buzzer_Beep(100);
+    TEST_CHECK_EQ(EdgeCount, 1);
+    TEST_CHECK_EQ(EdgeOn[0], 1);
+    TEST_CHECK_EQ(EdgeTick[0], 0);
+    TEST_CHECK_EQ(EdgeCycle[0], CYCLE_OF(4000));
+    TEST_CHECK_EQ(Stub_Pwm.Duty, CYCLE_OF(4000) / 2);
+
+    TickMs(99);
+    TEST_CHECK_EQ(Stub_Pwm.Enabled, 1);
+    TEST_CHECK_EQ(Buzzer_IsActive(), 1);
+    TickMs(1);
+    TEST_CHECK_EQ(EdgeCount, 2);
+    TEST_CHECK_EQ(EdgeOn[1], 0);
+    TEST_CHECK_EQ(EdgeTick[1], 100);
+    TEST_CHECK_EQ(Buzzer_IsActive(), 0);
+}
+
+/**
+  * @brief  ͣÿ30msͣ20ms3飬ľνſ
+  */
+static void Case_RepeatCount(void)
+{
+    static const Buzzer_ToneTypeDef tones[] = {
+        { 2000, 50, 30, 20 },
+    };
+    static const Buzzer_PatternTypeDef pattern = { tones, 1, 3, BUZZER_PRIORITY_NOTIFY };
+
+    Setup();
+    TEST_CHECK_EQ(Buzzer_Play(&pattern), 1);
+    TickMs(149);
+    TEST_CHECK_EQ(Buzzer_IsActive(), 1);
+    TickMs(1);
+    TEST_CHECK_EQ(Buzzer_IsActive(), 0);
+
+    TEST_CHECK_EQ(EdgeCount, 6);
+    for(uint32_t i = 0; i < 3; i++) {
+        TEST_CHECK_EQ(EdgeOn[i * 2], 1);
+        TEST_CHECK_EQ(EdgeTick[i * 2], i * 50);
+        TEST_CHECK_EQ(EdgeCycle[i * 2], CYCLE_OF(2000));
+        TEST_CHECK_EQ(EdgeOn[i * 2 + 1], 0);
+        TEST_CHECK_EQ(EdgeTick[i * 2 + 1], i * 50 + 30);
+    }
+
+    /* ƵΪ0ֹPWMر */
+    {
+        static const Buzzer_ToneTypeDef melody[] = {
+            { 1000, 50, 10, 0 },
+            { 0, 0, 15, 0 },
+            { 3000, 50, 10, 0 },
+        };
+        static const Buzzer_PatternTypeDef tune = { melody, 3, 2, BUZZER_PRIORITY_NOTIFY };
+
+        EdgeCount = 0;
+        Ticks = 0;
+        Buzzer_Play(&tune);
+        TickMs(35);
+        /* ڶ飺һ޾ΣPWMֻֿ */
+        TEST_CHECK_EQ(Stub_Pwm.Enabled, 1);
+        TEST_CHECK_EQ(Stub_Pwm.Cycle, CYCLE_OF(1000));
+        TickMs(35);
+        TEST_CHECK_EQ(Buzzer_IsActive(), 0);
+        TEST_CHECK_EQ(EdgeCount, 6);
+        TEST_CHECK_EQ(EdgeTick[0], 0);
+        TEST_CHECK_EQ(EdgeCycle[0], CYCLE_OF(1000));
+        TEST_CHECK_EQ(EdgeTick[1], 10);     // ֹ
+        TEST_CHECK_EQ(EdgeTick[2], 25);
+        TEST_CHECK_EQ(EdgeCycle[2], CYCLE_OF(3000));
+        TEST_CHECK_EQ(EdgeTick[3], 45);
+        TEST_CHECK_EQ(EdgeOn[3], 0);
+        TEST_CHECK_EQ(EdgeTick[4], 60);
+        TEST_CHECK_EQ(EdgeTick[5], 70);
+        TEST_CHECK_EQ(EdgeOn[5], 0);
+    }
+}
+
+/**
+  * @brief  ͬȼͰ˳򲥷ţʱµͬȼͱ
+  */
+static void Case_FifoEqualPriority(void)
+{
+    static const Buzzer_ToneTypeDef toneA[] = { { 1000, 50, 10, 5 } };
+    static const Buzzer_ToneTypeDef toneB[] = { { 2000, 50, 10, 5 } };
+    static const Buzzer_ToneTypeDef toneC[] = { { 3000, 50, 10, 5 } };
+    static const Buzzer_PatternTypeDef patternA = { toneA, 1, 1, BUZZER_PRIORITY_NOTIFY };
+    static const Buzzer_PatternTypeDef patternB = { toneB, 1, 1, BUZZER_PRIORITY_NOTIFY };
+    static const Buzzer_PatternTypeDef patternC = { toneC, 1, 1, BUZZER_PRIORITY_NOTIFY };
+
+    Setup();
+    TEST_CHECK_EQ(Buzzer_Play(&patternA), 1);
+    TEST_CHECK_EQ(Buzzer_Play(&patternB), 1);
+    TEST_CHECK_EQ(Buzzer_Play(&patternC), 1);
+    TEST_CHECK_EQ(Buzzer_Play(&patternA), 1);   // 4
+    TEST_CHECK_EQ(Buzzer_Play(&patternB), 0);   // 
+
+    TickMs(60);
+    TEST_CHECK_EQ(Buzzer_IsActive(), 0);
+    TEST_CHECK_EQ(EdgeCount, 8);
+    TEST_CHECK_EQ(EdgeCycle[0], CYCLE_OF(1000));
+    TEST_CHECK_EQ(EdgeCycle[2], CYCLE_OF(2000));
+    TEST_CHECK_EQ(EdgeCycle[4], CYCLE_OF(3000));
+    TEST_CHECK_EQ(EdgeCycle[6], CYCLE_OF(1000));
+    for(uint32_t i = 0; i < 4; i++) {
+        TEST_CHECK_EQ(EdgeTick[i * 2], i * 15);
+        TEST_CHECK_EQ(EdgeTick[i * 2 + 1], i * 15 + 10);
+    }
+}
+
+/**
+  * @brief  ϰʾڼȼͱֹܾͣ
+  */
+static void Case_AlarmPreemptsClick(void)
+{
+    static const Buzzer_ToneTypeDef toneN[] = { { 1000, 50, 10, 0 } };
+    static const Buzzer_PatternTypeDef notify = { toneN, 1, 1, BUZZER_PRIORITY_NOTIFY };
+
+    Setup();
+    Buzzer_SetFrequency(2000);
+    Buzzer_Beep(500);
+    TickMs(50);
+    TEST_CHECK_EQ(Stub_Pwm.Cycle, CYCLE_OF(2000));
+
+    /* 4kHz 200msͣ100ms */
+    Buzzer_Start();
+    TEST_CHECK_EQ(Stub_Pwm.Enabled, 1);
+    TEST_CHECK_EQ(Stub_Pwm.Cycle, CYCLE_OF(4000));
+    TickMs(200);
+    TEST_CHECK_EQ(Stub_Pwm.Enabled, 0);
+    TEST_CHECK_EQ(EdgeTick[EdgeCount - 1], 250);
+
+    /* аʾ״̬ʾ */
+    Buzzer_Beep(30);
+    TEST_CHECK_EQ(Buzzer_Play(&notify), 0);
+    TEST_CHECK_EQ(Stub_Pwm.Enabled, 0);
+    TickMs(100);
+    TEST_CHECK_EQ(Stub_Pwm.Enabled, 1);
+    TEST_CHECK_EQ(EdgeTick[EdgeCount - 1], 350);
+    TEST_CHECK_EQ(Stub_Pwm.Cycle, CYCLE_OF(4000));
+
+    /* ظ¼ʱ */
+    TickMs(50);
+    Buzzer_Start();
+    TickMs(150);
+    TEST_CHECK_EQ(Stub_Pwm.Enabled, 0);
+    TEST_CHECK_EQ(EdgeTick[EdgeCount - 1], 550);
+
+    /* ֹͣرPWMϵʾ */
+    TickMs(20);
+    Buzzer_Stop();
+    TEST_CHECK_EQ(Buzzer_IsActive(), 0);
+    TickMs(500);
+    TEST_CHECK_EQ(Stub_Pwm.Enabled, 0);
+    TEST_CHECK_EQ(EdgeTick[EdgeCount - 1], 550);
+}
+
+static const Test_CaseTypeDef Cases[] = {
+    { "beep_edges", Case_BeepEdges },
+    { "repeat_count", Case_RepeatCount },
+    { "fifo_equal_priority", Case_FifoEqualPriority },
+    { "alarm_preempts_click", Case_AlarmPreemptsClick },
+};
+
+int main(int argc, char** argv)
+{
+    return Test_Main(argc, argv, Cases, TEST_CASE_COUNT(Cases));
+}
@@ -0,0 +1,409 @@
+//test_num_format.c
+
+/*
+ * ָʽԣNumFormat_Round64λĲοʵֵȽϣ
+ * NumFormat_Asciisnprintfڡ2,000,000ΧֵȽϣ
+ * NumFormat_Segments/NumFormat_WeightĶ֡С͵λοʵֱȽϡ
+ * һʱֻӡһֵͳƲһµ
+ */
+#include "unit_test.h"
+#include "num_format.h"
+
+#define ASCII_RANGE         2000000L
+#define ROUND_RANDOM_COUNT  200000U
+#define DISPLAY_WIDTH       5           // seg_lcdled_segoled5λ
+#define SEGMENTS_RANGE      120000L     // 5λ֣ǳ
+#define WEIGHT_RANGE_MG     2000000L    // gmgȽϵķΧ
+#define WEIGHT_G_LIMIT_MG   10000000L   // 5λg9999.9g֮ϻkg
+#define WEIGHT_KG_LIMIT_MG  100000000L  // 5λkg99.999kg֮ϳ
+#define WEIGHT_BAND_MG      10000L      // ͳ̱߽mgȽϵķΧ
+#define WEIGHT_KG_STRIDE    101         // kgȫΧ˼
+
+/** @defgroup һ¼¼
+  * @{
+  */
+static uint32_t Mismatches = 0;
+
+/**
+  * @}
+  */
+
+static uint32_t RandState = 12345U;
+
+/**
+  * @brief  ͬα̶ӣɸ֣
+  */
+static uint32_t Rand32(void)
+{
+    RandState = RandState * 1664525U + 1013904223U;
+    return RandState;
+}
+
+/**
+  * @brief  οʵֵ֣뵽ֶȵλ󳬳int32_tʱȥĽ
+  */
+static int32_t Round_Reference(int32_t value, int64_t division)
+{
+    int64_t mag = (value < 0) ? -(int64_t)value : (int64_t)value;
+    int64_t residual = mag % division;
+
+    mag -= residual;
+    if(residual * 2 >= division && mag + division <= INT32_MAX) {
+        mag += division;
+    }
+    return (int32_t)((value < 0) ? -mag : mag);
+}
+
+static void Round_Check(int32_t value, uint8_t step, uint8_t exp, int64_t division)
+{
+    int32_t actual = NumFormat_Round(value, step, exp);
+    int32_t expected = Round_Reference(value, division);
+
+    if(actual != expected) {
+        if(Mismatches == 0) {
+            printf("NumFormat_Round(%ld, %u, %u) == %ld, expected %ld\n",
+                   (long)value, step, exp, (long)actual, (long)expected);
+        }
+        Mismatches++;
+    }
+}
+
+/**
+  * @brief  ֶ1/2/5  10^0..8ֶȺͰֶȸint32_t߽硢ֵ
+  */
+static void Case_RoundReference(void)
+{
+    static const uint8_t steps[] = { 1, 2, 5 };
+    static const int32_t edges[] = {
+        0, 1, -1, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1,
+        2147000000, -2147000000, 2000000000, -2000000000, 1999999999, -1999999999,
+    };
+    int64_t division = 1;
+
+    for(uint8_t s = 0; s < sizeof(steps); s++) {
+        division = steps[s];
+        for(uint8_t exp = 0; exp <= 8; exp++, division *= 10) {
+            for(uint32_t i = 0; i < TEST_CASE_COUNT(edges); i++) {
+                Round_Check(edges[i], steps[s], exp, division);
+            }
+
+            /* ǰɸֶȣԼINT32_MAX/INT32_MIN󼸸ֶ */
+            for(int64_t k = -3; k <= 3; k++) {
+                int64_t bases[3];
+                bases[0] = k * division;
+                bases[1] = (INT32_MAX / division + k) * division;
+                bases[2] = -(INT32_MAX / division + k) * division;
+                for(uint32_t b = 0; b < 3; b++) {
+                    const int64_t offsets[] = {
+                        -1, 0, 1, division / 2 - 1, division / 2, division / 2 + 1, division - 1,
+                    };
+                    for(uint32_t o = 0; o < TEST_CASE_COUNT(offsets); o++) {
+                        int64_t v = bases[b] + offsets[o];
+                        if(v >= INT32_MIN && v <= INT32_MAX) {
+                            Round_Check((int32_t)v, steps[s], exp, division);
+                        }
+                        v = bases[b] - offsets[o];
+                        if(v >= INT32_MIN && v <= INT32_MAX) {
+                            Round_Check((int32_t)v, steps[s], exp, division);
+                        }
+                    }
+                }
+            }
+
+            for(uint32_t i = 0; i < ROUND_RANDOM_COUNT; i++) {
+                Round_Check((int32_t)Rand32(), steps[s], exp, division);
+            }
+        }
+    }
+    TEST_CHECK_EQ(Mismatches, 0);
+}
+
+/**
+  * @brief  οʵ֣snprintfɴСַ
+  * @retval ַ
+  */
+static int Ascii_Text(int32_t value, uint8_t decimals, char* text, size_t size)
+{
+    static const uint32_t pow10[] = { 1U, 10U, 100U, 1000U };
+    uint32_t mag = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+
+    if(decimals == 0) {
+        return snprintf(text, size, "%s%lu", (value < 0) ? "-" : "", (unsigned long)mag);
+    }
+    return snprintf(text, size, "%s%lu.%0*lu", (value < 0) ? "-" : "",
+                    (unsigned long)(mag / pow10[decimals]), decimals,
+                    (unsigned long)(mag % pow10[decimals]));
+}
+
+/**
+  * @brief  οַȽϣҶ󲹿ո񣬳ʱȫΪ'-'NUMFMT_OVERFLOW
+  */
+static void Ascii_Check(int32_t value, uint8_t decimals, uint8_t width, const char* text, int len)
+{
+    char actual[16];
+    char expected[16];
+    uint8_t actualFlags = NumFormat_Ascii(value, decimals, actual, width);
+    uint8_t expectedFlags = (value < 0) ? NUMFMT_NEGATIVE : 0;
+
+    if(len > width) {
+        memset(expected, '-', width);
+        expectedFlags |= NUMFMT_OVERFLOW;
+    } else {
+        memset(expected, ' ', width - len);
+        memcpy(&expected[width - len], text, (size_t)len);
+    }
+    expected[width] = '\0';
+
+    if(actualFlags != expectedFlags || strcmp(actual, expected) != 0) {
+        if(Mismatches == 0) {
+            printf("NumFormat_Ascii(%ld, %u, %u) == \"%s\"/0x%02X, expected \"%s\"/0x%02X\n",
+                   (long)value, decimals, width, actual, actualFlags, expected, expectedFlags);
+        }
+        Mismatches++;
+    }
+}
+
+/**
+  * @brief  2,000,000ֵȽϣ9ᳬ6ǳ
+  */
+static void Ascii_Sweep(uint8_t decimals)
+{
+    char text[24];
+    int len;
+
+    for(int32_t value = -ASCII_RANGE; value <= ASCII_RANGE; value++) {
+        len = Ascii_Text(value, decimals, text, sizeof(text));
+        Ascii_Check(value, decimals, 9, text, len);
+        Ascii_Check(value, decimals, 6, text, len);
+    }
+    TEST_CHECK_EQ(Mismatches, 0);
+}
+
+static void Case_AsciiDecimals0(void) { Ascii_Sweep(0); }
+static void Case_AsciiDecimals1(void) { Ascii_Sweep(1); }
+static void Case_AsciiDecimals2(void) { Ascii_Sweep(2); }
+static void Case_AsciiDecimals3(void) { Ascii_Sweep(3); }
+
+/**
+  * @brief  Ϊıÿλһַոֻ'-'Сʱ'.'ʶΪ'?'
+  */
+static void Segments_Decode(const uint8_t* segs, uint8_t width, char* text)
+{
+    static const uint8_t font[10] = { 0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F };
+    uint8_t shape;
+    char c;
+
+    for(uint8_t i = 0; i < width; i++) {
+        shape = segs[i] & (uint8_t)~NUMFMT_SEG_DP;
+        c = '?';
+        if(shape == 0) {
+            c = ' ';
+        } else if(shape == NUMFMT_SEG_MINUS) {
+            c = '-';
+        } else {
+            for(uint8_t d = 0; d < 10; d++) {
+                if(font[d] == shape) c = (char)('0' + d);
+            }
+        }
+        *text++ = c;
+        if(segs[i] & NUMFMT_SEG_DP) *text++ = '.';
+    }
+    *text = '\0';
+}
+
+/**
+  * @brief  οʵ֣ţǰλdecimalsλС
+  *         widthλСλwidthʱȫΪ'-'
+  */
+static uint8_t Segments_Reference(int32_t value, uint8_t decimals, uint8_t width, char* text)
+{
+    char digits[16];
+    uint32_t mag = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+    uint8_t flags = (value < 0) ? NUMFMT_NEGATIVE : 0;
+    int len = snprintf(digits, sizeof(digits), "%0*lu", decimals + 1, (unsigned long)mag);
+
+    if(decimals >= width || len > width) {
+        memset(text, '-', width);
+        text[width] = '\0';
+        return flags | NUMFMT_OVERFLOW;
+    }
+    memset(text, ' ', width - len);
+    text += width - len;
+    for(int i = 0; i < len; i++) {
+        *text++ = digits[i];
+        if(decimals != 0 && i == len - 1 - decimals) *text++ = '.';
+    }
+    *text = '\0';
+    return flags;
+}
+
+static void Segments_Check(int32_t value, uint8_t decimals)
+{
+    uint8_t segs[DISPLAY_WIDTH];
+    char actual[2 * DISPLAY_WIDTH + 1];
+    char expected[2 * DISPLAY_WIDTH + 1];
+    uint8_t actualFlags = NumFormat_Segments(value, decimals, segs, DISPLAY_WIDTH);
+    uint8_t expectedFlags = Segments_Reference(value, decimals, DISPLAY_WIDTH, expected);
+
+    Segments_Decode(segs, DISPLAY_WIDTH, actual);
+    if(actualFlags != expectedFlags || strcmp(actual, expected) != 0) {
+        if(Mismatches == 0) {
+            printf("NumFormat_Segments(%ld, %u) == \"%s\"/0x%02X, expected \"%s\"/0x%02X\n",
+                   (long)value, decimals, actual, actualFlags, expected, expectedFlags);
+        }
+        Mismatches++;
+    }
+}
+
+/**
+  * @brief  ֵȽϣ0-5λС5λСʱȫǰСλúͳ
+  */
+static void Case_SegmentsSweep(void)
+{
+    for(int32_t value = -SEGMENTS_RANGE; value <= SEGMENTS_RANGE; value++) {
+        for(uint8_t decimals = 0; decimals <= DISPLAY_WIDTH; decimals++) {
+            Segments_Check(value, decimals);
+        }
+    }
+    Segments_Check(INT32_MAX, 0);
+    Segments_Check(INT32_MIN, 2);
+    TEST_CHECK_EQ(Mismatches, 0);
+}
+
+/**
+  * @brief  οʵ֣gstep100mgȡʾ1λСŲʱkgstep1000mgȡʾ3λС
+  *         ű־ȡȡȡΪ0ʱ㸺
+  */
+static uint8_t Weight_Reference(int32_t milligram, uint8_t step, char* text, NumFormat_Unit* unit)
+{
+    int32_t rounded = Round_Reference(milligram, (int64_t)step * 100);
+    uint8_t flags = Segments_Reference(rounded / 100, 1, DISPLAY_WIDTH, text);
+
+    *unit = NUMFMT_UNIT_G;
+    if(flags & NUMFMT_OVERFLOW) {
+        rounded = Round_Reference(milligram, (int64_t)step * 1000);
+        flags = Segments_Reference(rounded / 1000, 3, DISPLAY_WIDTH, text);
+        *unit = NUMFMT_UNIT_KG;
+    }
+    return flags;
+}
+
+static void Weight_Check(int32_t milligram, uint8_t step)
+{
+    uint8_t segs[DISPLAY_WIDTH];
+    char actual[2 * DISPLAY_WIDTH + 1];
+    char expected[2 * DISPLAY_WIDTH + 1];
+    NumFormat_Unit actualUnit, expectedUnit;
+    uint8_t actualFlags = NumFormat_Weight(milligram, step, segs, DISPLAY_WIDTH, &actualUnit);
+    uint8_t expectedFlags = Weight_Reference(milligram, step, expected, &expectedUnit);
+
+    Segments_Decode(segs, DISPLAY_WIDTH, actual);
+    if(actualFlags != expectedFlags || actualUnit != expectedUnit || strcmp(actual, expected) != 0) {
+        if(Mismatches == 0) {
+            printf("NumFormat_Weight(%ld, %u) == \"%s\"/0x%02X/%s, expected \"%s\"/0x%02X/%s\n",
+                   (long)milligram, step, actual, actualFlags, actualUnit == NUMFMT_UNIT_KG ? "kg" : "g",
+                   expected, expectedFlags, expectedUnit == NUMFMT_UNIT_KG ? "kg" : "g");
+        }
+        Mismatches++;
+    }
+}
+
+/**
+  * @brief  Ƚ[from, to]ڵÿֵ෴
+  */
+static void Weight_CheckBand(int32_t from, int32_t to, int32_t stride, uint8_t step)
+{
+    for(int32_t mg = from; mg <= to; mg += stride) {
+        Weight_Check(mg, step);
+        Weight_Check(-mg, step);
+    }
+}
+
+/**
+  * @brief  ʾgmgg/kgkg̱߽mgkgȫΧint32_t߽
+  */
+static void Weight_Sweep(uint8_t step)
+{
+    Weight_CheckBand(0, WEIGHT_RANGE_MG, 1, step);
+    Weight_CheckBand(WEIGHT_G_LIMIT_MG - WEIGHT_BAND_MG, WEIGHT_G_LIMIT_MG + WEIGHT_BAND_MG, 1, step);
+    Weight_CheckBand(WEIGHT_KG_LIMIT_MG - WEIGHT_BAND_MG, WEIGHT_KG_LIMIT_MG + WEIGHT_BAND_MG, 1, step);
+    Weight_CheckBand(WEIGHT_RANGE_MG, WEIGHT_KG_LIMIT_MG + WEIGHT_BAND_MG, WEIGHT_KG_STRIDE, step);
+    Weight_Check(INT32_MAX, step);
+    Weight_Check(INT32_MIN, step);
+    TEST_CHECK_EQ(Mismatches, 0);
+}
+
+static void Case_WeightStep1(void) { Weight_Sweep(1); }
+static void Case_WeightStep2(void) { Weight_Sweep(2); }
+static void Case_WeightStep5(void) { Weight_Sweep(5); }
+
+/**
+  * @brief  ʾı
+  */
+static void Case_WeightExamples(void)
+{
+    uint8_t segs[DISPLAY_WIDTH];
+    char text[2 * DISPLAY_WIDTH + 1];
+    NumFormat_Unit unit;
+
+    TEST_CHECK_EQ(NumFormat_Weight(-49, 1, segs, DISPLAY_WIDTH, &unit), 0);    // ȡΪ0
+    Segments_Decode(segs, DISPLAY_WIDTH, text);
+    TEST_CHECK(strcmp(text, "   0.0") == 0);
+
+    TEST_CHECK_EQ(NumFormat_Weight(-1250, 5, segs, DISPLAY_WIDTH, &unit), NUMFMT_NEGATIVE);
+    Segments_Decode(segs, DISPLAY_WIDTH, text);
+    TEST_CHECK(strcmp(text, "   1.5") == 0);
+    TEST_CHECK_EQ(unit, NUMFMT_UNIT_G);
+
+    TEST_CHECK_EQ(NumFormat_Weight(9999949, 1, segs, DISPLAY_WIDTH, &unit), 0);
+    Segments_Decode(segs, DISPLAY_WIDTH, text);
+    TEST_CHECK(strcmp(text, "9999.9") == 0);
+    TEST_CHECK_EQ(unit, NUMFMT_UNIT_G);
+
+    TEST_CHECK_EQ(NumFormat_Weight(9999950, 1, segs, DISPLAY_WIDTH, &unit), 0);  // λ10000.0gkg
+    Segments_Decode(segs, DISPLAY_WIDTH, text);
+    TEST_CHECK(strcmp(text, "10.000") == 0);
+    TEST_CHECK_EQ(unit, NUMFMT_UNIT_KG);
+
+    TEST_CHECK_EQ(NumFormat_Weight(100000000, 1, segs, DISPLAY_WIDTH, &unit), NUMFMT_OVERFLOW);
+    Segments_Decode(segs, DISPLAY_WIDTH, text);
+    TEST_CHECK(strcmp(text, "-----") == 0);
+}
+
+/**
+  * @brief  int32_t߽
+  */
+static void Case_AsciiEdges(void)
+{
+    char buf[16];
+
+    TEST_CHECK_EQ(NumFormat_Ascii(INT32_MAX, 0, buf, 11), 0);
+    TEST_CHECK(strcmp(buf, " 2147483647") == 0);
+    TEST_CHECK_EQ(NumFormat_Ascii(INT32_MIN, 0, buf, 11), NUMFMT_NEGATIVE);
+    TEST_CHECK(strcmp(buf, "-2147483648") == 0);
+    TEST_CHECK_EQ(NumFormat_Ascii(INT32_MIN, 3, buf, 12), NUMFMT_NEGATIVE);
+    TEST_CHECK(strcmp(buf, "-2147483.648") == 0);
+    TEST_CHECK_EQ(NumFormat_Ascii(INT32_MIN, 3, buf, 11), NUMFMT_NEGATIVE | NUMFMT_OVERFLOW);
+    TEST_CHECK(strcmp(buf, "-----------") == 0);
+    TEST_CHECK_EQ(NumFormat_Ascii(-5, 3, buf, 6), NUMFMT_NEGATIVE);
+    TEST_CHECK(strcmp(buf, "-0.005") == 0);
+}
+
+static const Test_CaseTypeDef Cases[] = {
+    { "round_reference", Case_RoundReference },
+    { "ascii_decimals_0", Case_AsciiDecimals0 },
+    { "ascii_decimals_1", Case_AsciiDecimals1 },
+    { "ascii_decimals_2", Case_AsciiDecimals2 },
+    { "ascii_decimals_3", Case_AsciiDecimals3 },
+    { "ascii_edges", Case_AsciiEdges },
+    { "segments_sweep", Case_SegmentsSweep },
+    { "weight_step_1", Case_WeightStep1 },
+    { "weight_step_2", Case_WeightStep2 },
+    { "weight_step_5", Case_WeightStep5 },
+    { "weight_examples", Case_WeightExamples },
+};
+
+int main(int argc, char** argv)
+{
+    return Test_Main(argc, argv, Cases, TEST_CASE_COUNT(Cases));
+}
@@ -0,0 +1,409 @@
+//test_scheduler.c
+
+/*
+ * Эʽԣʱ滻ΪģʱӣͿлصƽģʱ䣬
+ * ֤/λȼ˳򡢽ֹʱִʱͳƺжϡ
+ */
+#include "unit_test.h"
+#include "system_timer.h"
+#include "sc32f1xxx_pwr.h"
+
+#define LOG_SIZE    64
+
+/** @defgroup ģʱӺִм¼
+  * @{
+  */
+static uint32_t FakeUs = 0;                 // ģʱ(us)
+static uint32_t TaskExecUs[4];              // ÿִĵģʱ
+static uint8_t LogTask[LOG_SIZE];           // ִм¼
+static uint32_t LogMs[LOG_SIZE];            // ִм¼ʼʱ(ms)
+static uint32_t LogCount = 0;
+static uint8_t PendingWork = 0;             // ģ¼д¼
+static uint32_t IdleHookCalls = 0;
+static uint32_t IdleHookIrqMasked = 0;      // лصʱжϴڹر״̬Ĵ
+static uint32_t IdleSleepUs = 0;            // ÿοлصƽģʱ
+static uint32_t PostAtUs = 0;               // ģжڸʱͶ¼0ʾͶݣ
+
+/**
+  * @}
+  */
+
+static uint32_t FakeNowMs(void)
+{
+    return FakeUs / 1000;
+}
+
+static uint32_t FakeNowUs(void)
+{
+    return FakeUs;
+}
+
+static void Log_Run(uint8_t task)
+{
+    if(LogCount < LOG_SIZE) {
+        LogTask[LogCount] = task;
+        LogMs[LogCount] = FakeNowMs();
+        LogCount++;
+    }
+    FakeUs += TaskExecUs[task];
+}
+
+static void Task0(void) { Log_Run(0); }
+static void Task1(void) { Log_Run(1); }
+static void Task2(void) { Log_Run(2); }
+static void Task3(void) { Log_Run(3); }
+
+static uint8_t Fake_PendingCheck(void)
+{
+    return PendingWork;
+}
+
+/**
+  * @brief  лصģߵһж
+  */
+static void Fake_IdleHook(void)
+{
+    IdleHookCalls++;
+    if(__get_PRIMASK()) IdleHookIrqMasked++;
+    FakeUs += IdleSleepUs;
+    if(PostAtUs != 0 && FakeUs >= PostAtUs) {
+        PendingWork = 1;
+    }
+}
+
+/**
+  * @brief  ʹģʱӣ0ʱ̿ʼ
+  */
+static void Fake_Start(void)
+{
+    FakeUs = 0;
+    Scheduler_SetClock(FakeNowMs, FakeNowUs);
+}
+
+static int8_t AddTask(void (*function)(void), uint32_t periodMs, uint32_t phaseMs,
+                      uint8_t priority, uint32_t budgetUs)
+{
+    SchedTask_InitTypeDef task;
+
+    task.Function = function;
+    task.PeriodMs = periodMs;
+    task.PhaseMs = phaseMs;
+    task.Priority = priority;
+    task.BudgetUs = budgetUs;
+    return Scheduler_AddTask(&task);
+}
+
+/**
+  * @brief  ƽģʱӵendMsÿִȫ
+  */
+static void RunUntilMs(uint32_t endMs)
+{
+    while(FakeNowMs() < endMs) {
+        while(Scheduler_RunOnce()) {
+        }
+        FakeUs = (FakeNowMs() + 1) * 1000;
+    }
+}
+
+/**
+  * @brief  ںλ10ms0ʼ20ms5ms
+  */
+static void Case_PeriodPhase(void)
+{
+    uint32_t count0 = 0, count1 = 0;
+
+    Fake_Start();
+    TEST_CHECK_EQ(AddTask(Task0, 10, 0, 1, 0), 0);
+    TEST_CHECK_EQ(AddTask(Task1, 20, 5, 1, 0), 1);
+    Scheduler_Start();
+    RunUntilMs(100);
+
+    for(uint32_t i = 0; i < LogCount; i++) {
+        if(LogTask[i] == 0) {
+            TEST_CHECK_EQ(LogMs[i], count0 * 10);
+            count0++;
+        } else {
+            TEST_CHECK_EQ(LogMs[i], 5 + count1 * 20);
+            count1++;
+        }
+    }
+    TEST_CHECK_EQ(count0, 10);
+    TEST_CHECK_EQ(count1, 5);
+    TEST_CHECK_EQ(Scheduler_GetStats(0)->DeadlineMisses, 0);
+    TEST_CHECK_EQ(Scheduler_GetStats(1)->MaxLatenessMs, 0);
+}
+
+/**
+  * @brief  ͬʱʱȼִУͬȼִͷŽ
+  */
+static void Case_PriorityOrder(void)
+{
+    Fake_Start();
+    AddTask(Task2, 10, 0, 2, 0);
+    AddTask(Task0, 10, 0, 0, 0);
+    AddTask(Task1, 10, 0, 1, 0);
+    Scheduler_Start();
+    while(Scheduler_RunOnce()) {
+    }
+    TEST_CHECK_EQ(LogCount, 3);
+    TEST_CHECK_EQ(LogTask[0], 0);
+    TEST_CHECK_EQ(LogTask[1], 1);
+    TEST_CHECK_EQ(LogTask[2], 2);
+
+    /* ͬȼǼǵͷŵִ */
+    LogCount = 0;
+    FakeUs = 0;
+    AddTask(Task3, 10, 3, 4, 0);
+    {
+        SchedTask_InitTypeDef early = { Task1, 10, 0, 4, 0 };
+        Scheduler_AddTask(&early);
+    }
+    Scheduler_Start();
+    FakeUs = 5000;
+    while(Scheduler_RunOnce()) {
+    }
+    /* 0msͷŵTask0/1/2Task1ȼ4ȺִУ3msͷŵTask3 */
+    TEST_CHECK_EQ(LogCount, 5);
+    TEST_CHECK_EQ(LogTask[0], 0);
+    TEST_CHECK_EQ(LogTask[1], 1);
+    TEST_CHECK_EQ(LogTask[2], 2);
+    TEST_CHECK_EQ(LogTask[3], 1);
+    TEST_CHECK_EQ(LogTask[4], 3);
+}
+
+/**
+  * @brief  ͷӳٳʱֹʱڲλ
+  */
+static void Case_DeadlineMiss(void)
+{
+    const SchedTask_StatsTypeDef* stats;
+
+    Fake_Start();
+    AddTask(Task0, 10, 0, 0, 0);
+    Scheduler_Start();
+    TEST_CHECK_EQ(Scheduler_RunOnce(), 1);
+
+    FakeUs = 35000;                 // 102030msͷŶûִ
+    TEST_CHECK_EQ(Scheduler_RunOnce(), 1);
+    TEST_CHECK_EQ(Scheduler_RunOnce(), 0);
+    stats = Scheduler_GetStats(0);
+    TEST_CHECK_EQ(stats->DeadlineMisses, 2);
+    TEST_CHECK_EQ(stats->MaxLatenessMs, 25);
+    TEST_CHECK_EQ(stats->RunCount, 2);
+
+    FakeUs = 39999;
+    TEST_CHECK_EQ(Scheduler_RunOnce(), 0);
+    FakeUs = 40000;                 // λ䣺´ͷ40ms
+    TEST_CHECK_EQ(Scheduler_RunOnce(), 1);
+    TEST_CHECK_EQ(stats->DeadlineMisses, 2);
+}
+
+/**
+  * @brief  ִʱͳƣִʱ䡢ϴִʱԤ㳬޴
+  */
+static void Case_ExecStats(void)
+{
+    static const uint32_t execUs[] = { 50, 150, 80, 120, 30 };
+    const SchedTask_StatsTypeDef* stats;
+
+    Fake_Start();
+    AddTask(Task0, 1, 0, 0, 100);
+    AddTask(Task1, 1, 0, 1, 0);     // ԤΪ0
+    Scheduler_Start();
+
+    for(uint32_t i = 0; i < sizeof(execUs) / sizeof(execUs[0]); i++) {
+        TaskExecUs[0] = execUs[i];
+        TaskExecUs[1] = 500;
+        FakeUs = i * 1000;
+        while(Scheduler_RunOnce()) {
+        }
+    }
+
+    stats = Scheduler_GetStats(0);
+    TEST_CHECK_EQ(stats->RunCount, 5);
+    TEST_CHECK_EQ(stats->MaxExecUs, 150);
+    TEST_CHECK_EQ(stats->LastExecUs, 30);
+    TEST_CHECK_EQ(stats->BudgetOverruns, 2);
+
+    stats = Scheduler_GetStats(1);
+    TEST_CHECK_EQ(stats->MaxExecUs, 500);
+    TEST_CHECK_EQ(stats->BudgetOverruns, 0);
+
+    Scheduler_ResetStats();
+    TEST_CHECK_EQ(Scheduler_GetStats(0)->MaxExecUs, 0);
+    TEST_CHECK(Scheduler_GetStats(2) == 0);
+}
+
+/**
+  * @brief  жϣе¼ʱߣлصڹж״̬µ
+  */
+static void Case_SleepDecision(void)
+{
+    Fake_Start();
+    AddTask(Task0, 10, 0, 0, 0);
+    Scheduler_SetPendingCheck(Fake_PendingCheck);
+    Scheduler_Start();
+
+    /* 0msڣִ񣬲 */
+    Scheduler_Run();
+    TEST_CHECK_EQ(LogCount, 1);
+    TEST_CHECK_EQ(Stub_IdleCount, 0);
+
+    /* ûплصʱIDLEģʽģߵ10ms */
+    FakeUs = 1000;
+    Stub_SleepHook = Fake_IdleHook;
+    IdleSleepUs = 9000;
+    Scheduler_Run();
+    TEST_CHECK(Stub_IdleCount >= 1);
+    TEST_CHECK_EQ(__get_PRIMASK(), 0);
+
+    /* д¼ */
+    Stub_SleepHook = 0;
+    Scheduler_SetIdleHook(Fake_IdleHook);
+    IdleHookCalls = 0;
+    IdleHookIrqMasked = 0;
+    FakeUs = 11000;
+    PendingWork = 1;
+    Scheduler_Run();
+    TEST_CHECK_EQ(IdleHookCalls, 0);
+
+    /* ¼޵񣺵ÿлصжϣغж */
+    PendingWork = 0;
+    IdleSleepUs = 1000;
+    Scheduler_Run();
+    TEST_CHECK(IdleHookCalls >= 1);
+    TEST_CHECK_EQ(IdleHookIrqMasked, IdleHookCalls);
+    TEST_CHECK_EQ(__get_PRIMASK(), 0);
+}
+
+/**
+  * @brief  ռձȣÿ1ms100us900usͳƴڽԼΪ10%
+  */
+static void Case_AwakeDutyCycle(void)
+{
+    Fake_Start();
+    TaskExecUs[0] = 100;
+    AddTask(Task0, 1, 0, 0, 0);
+    Scheduler_SetIdleHook(Fake_IdleHook);
+    IdleSleepUs = 900;
+    Scheduler_Start();
+
+    while(FakeUs < (SCHED_DUTY_WINDOW_MS + 5) * 1000) {
+        Scheduler_Run();
+    }
+    TEST_CHECK(Scheduler_GetAwakePermille() >= 95);
+    TEST_CHECK(Scheduler_GetAwakePermille() <= 105);
+}
+
+/**
+  * @brief  жʱSysTickѻƵжϹ𣺰־1msλʱλλ
+  */
+static void Case_SnapshotPendingTick(void)
+{
+    uint32_t load;
+
+    SystemTimer_Init();
+    load = Stub_SysTick.LOAD;
+    TEST_CHECK_EQ(load, 7999);                  // 64MHz/81ms
+    SystemTimer_AdvanceMs(0xFFFFFFFF);
+
+    /* 𵫼ֵں̣Ʒڶȡ֮󣬲 */
+    Stub_SCB.ICSR = SCB_ICSR_PENDSTSET_Msk;
+    Stub_SysTick.VAL = 100;
+    TEST_CHECK_EQ(GetSystemTimeMs64(), 0xFFFFFFFFULL);
+    TEST_CHECK_EQ(GetSystemTimeUs64(), 0xFFFFFFFFULL * 1000 + (load - 100) / 8);
+
+    /* Ҹװ1msλƽλλ */
+    Stub_SysTick.VAL = load - 80;
+    TEST_CHECK_EQ(GetSystemTimeMs64(), 0x100000000ULL);
+    TEST_CHECK_EQ(GetSystemTimeUs64(), 0x100000000ULL * 1000 + 10);
+
+    /* жִк */
+    Stub_SCB.ICSR = 0;
+    SystemTimer_SysTick_IRQHandler();
+    TEST_CHECK_EQ(GetSystemTimeMs64(), 0x100000000ULL);
+    TEST_CHECK_EQ(GetSystemTimeMs(), 0);
+}
+
+/**
+  * @brief  ڼÿ1msSysTickѲصѭֱڻ¼Ͷ
+  */
+static void Case_IdleStaysAsleep(void)
+{
+    Fake_Start();
+    TaskExecUs[0] = 200;
+    AddTask(Task0, 50, 0, 0, 0);
+    Scheduler_SetPendingCheck(Fake_PendingCheck);
+    Scheduler_SetIdleHook(Fake_IdleHook);
+    IdleSleepUs = 1000;
+    Scheduler_Start();
+
+    /* 0msִ֮һScheduler_Run˯50msͷţSysTick50Σ */
+    Scheduler_Run();
+    Scheduler_Run();
+    TEST_CHECK_EQ(FakeUs, 50200);
+    TEST_CHECK_EQ(IdleHookCalls, 50);
+    TEST_CHECK_EQ(LogCount, 1);
+    TEST_CHECK_EQ(__get_PRIMASK(), 0);
+
+    /* ִ50msߣ57ms¼Ͷݺѭַ */
+    Scheduler_Run();
+    IdleHookCalls = 0;
+    PostAtUs = 57000;
+    Scheduler_Run();
+    TEST_CHECK_EQ(FakeUs, 57400);
+    TEST_CHECK_EQ(IdleHookCalls, 7);
+    PendingWork = 0;
+    PostAtUs = 0;
+
+    /* һͳƴִֻʱѣ200us/50ms = 4 */
+    while(FakeUs < (SCHED_DUTY_WINDOW_MS + 100) * 1000) {
+        Scheduler_Run();
+    }
+    TEST_CHECK(Scheduler_GetAwakePermille() <= 5);
+}
+
+/**
+  * @brief  STOPʱ䣺ͷʱһƣΪֹʱѺ󱣳λ
+  */
+static void Case_AdvanceRebase(void)
+{
+    const SchedTask_StatsTypeDef* stats;
+
+    Fake_Start();
+    AddTask(Task0, 10, 0, 0, 0);
+    AddTask(Task1, 20, 5, 1, 0);
+    Scheduler_Start();
+    RunUntilMs(6);                  // 0ms5msִһΣ´ͷ10ms25ms
+
+    /* 6msSTOP1000msBTMʱ */
+    FakeUs = 1006000;
+    SystemTimer_AdvanceMs(1000);
+    TEST_CHECK_EQ(Scheduler_RunOnce(), 0);
+
+    RunUntilMs(1026);
+    stats = Scheduler_GetStats(0);
+    TEST_CHECK_EQ(stats->DeadlineMisses, 0);
+    TEST_CHECK_EQ(stats->MaxLatenessMs, 0);
+    TEST_CHECK_EQ(stats->RunCount, 3);
+    TEST_CHECK_EQ(Scheduler_GetStats(1)->DeadlineMisses, 0);
+    TEST_CHECK_EQ(Scheduler_GetStats(1)->RunCount, 2);
+    TEST_CHECK_EQ(LogMs[LogCount - 1], 1025);
+}
+
+static const Test_CaseTypeDef Cases[] = {
+    { "period_phase", Case_PeriodPhase },
+    { "priority_order", Case_PriorityOrder },
+    { "deadline_miss", Case_DeadlineMiss },
+    { "exec_stats", Case_ExecStats },
+    { "sleep_decision", Case_SleepDecision },
+    { "awake_duty_cycle", Case_AwakeDutyCycle },
+    { "snapshot_pending_tick", Case_SnapshotPendingTick },
+    { "idle_stays_asleep", Case_IdleStaysAsleep },
+    { "advance_rebase", Case_AdvanceRebase },
+};
+
+int main(int argc, char** argv)
+{
+    return Test_Main(argc, argv, Cases, TEST_CASE_COUNT(Cases));
+}
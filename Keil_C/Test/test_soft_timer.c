@@ -0,0 +1,190 @@
+//test_soft_timer.c
+
+/*
+ * ʱԣSysTickже
+ * ֻ֤жʱʱͶ¼ַ¼ִлص
+ */
+#include "unit_test.h"
+#include "soft_timer.h"
+#include "event_queue.h"
+
+/** @defgroup ص¼
+  * @{
+  */
+static uint32_t ExpireCount = 0;
+static uint32_t ExpireMs[16];
+static uint32_t EventCount = 0;             // Ͷݵĵ¼
+
+/**
+  * @}
+  */
+
+static void Timer_Expired(void* arg)
+{
+    (void)arg;
+    if(ExpireCount < 16) {
+        ExpireMs[ExpireCount] = GetSystemTimeMs();
+    }
+    ExpireCount++;
+}
+
+/**
+  * @brief  ģһSysTickжϣSC_it.cеĵ˳ͬ
+  */
+static void Tick(void)
+{
+    uint8_t pending = EventQueue_IsPending();
+
+    SystemTimer_SysTick_IRQHandler();
+    SoftTimer_SysTickHandler();
+    if(!pending && EventQueue_IsPending()) {
+        EventCount++;
+    }
+}
+
+/**
+  * @brief  app_init.cͬ¼ȳʼʱʼʱĵ¼
+  */
+static void Setup(void)
+{
+    EventQueue_Init();
+    SystemTimer_Init();
+}
+
+/**
+  * @brief  ζʱǰͶ¼ڵĺͶһ
+  */
+static void Case_OneShot(void)
+{
+    SoftTimer_t timer;
+
+    Setup();
+    SoftTimer_Create(&timer, Timer_Expired, 0);
+    SoftTimer_Start(&timer, 5, 0);
+
+    for(uint32_t ms = 1; ms < 5; ms++) {
+        Tick();
+        TEST_CHECK_EQ(EventQueue_IsPending(), 0);
+    }
+    Tick();
+    TEST_CHECK_EQ(EventQueue_IsPending(), 1);
+    EventQueue_Dispatch();
+    TEST_CHECK_EQ(ExpireCount, 1);
+    TEST_CHECK_EQ(ExpireMs[0], 5);
+    TEST_CHECK_EQ(SoftTimer_IsActive(&timer), 0);
+
+    for(uint32_t ms = 6; ms < 100; ms++) {
+        Tick();
+    }
+    TEST_CHECK_EQ(EventCount, 1);
+}
+
+/**
+  * @brief  ڶʱ100ms10εڣѭֻ10
+  */
+static void Case_Periodic(void)
+{
+    SoftTimer_t timer;
+
+    Setup();
+    SoftTimer_Create(&timer, Timer_Expired, 0);
+    SoftTimer_Start(&timer, 10, 10);
+
+    for(uint32_t ms = 1; ms <= 100; ms++) {
+        Tick();
+        EventQueue_Dispatch();
+    }
+    TEST_CHECK_EQ(EventCount, 10);
+    TEST_CHECK_EQ(ExpireCount, 10);
+    for(uint32_t i = 0; i < 10; i++) {
+        TEST_CHECK_EQ(ExpireMs[i], (i + 1) * 10);
+    }
+}
+
+/**
+  * @brief  һȦʱͬһǰʱͶ
+  */
+static void Case_WheelLap(void)
+{
+    SoftTimer_t timer;
+
+    Setup();
+    SoftTimer_Create(&timer, Timer_Expired, 0);
+    SoftTimer_Start(&timer, SOFT_TIMER_WHEEL_SIZE + 8, 0);
+
+    for(uint32_t ms = 1; ms < SOFT_TIMER_WHEEL_SIZE + 8; ms++) {
+        Tick();
+    }
+    TEST_CHECK_EQ(EventCount, 0);
+    Tick();
+    EventQueue_Dispatch();
+    TEST_CHECK_EQ(EventCount, 1);
+    TEST_CHECK_EQ(ExpireCount, 1);
+}
+
+/**
+  * @brief  ʱڱ־һͶ
+  */
+static void Case_QueueFullRetry(void)
+{
+    SoftTimer_t timer;
+
+    Setup();
+    SoftTimer_Create(&timer, Timer_Expired, 0);
+    SoftTimer_Start(&timer, 3, 0);
+
+    Tick();
+    Tick();
+    for(uint32_t i = 0; i < EVENT_QUEUE_SIZE; i++) {
+        EventQueue_Post(EVENT_UART_RX, (uint8_t)i, 0);
+    }
+    Tick();                                 // ڣ
+    TEST_CHECK_EQ(EventQueue_GetOverflowCount(), 1);
+    EventQueue_Dispatch();
+    TEST_CHECK_EQ(ExpireCount, 0);
+
+    Tick();                                 // һĲѲͬȻͶ
+    TEST_CHECK_EQ(EventQueue_IsPending(), 1);
+    EventQueue_Dispatch();
+    TEST_CHECK_EQ(ExpireCount, 1);
+    TEST_CHECK_EQ(ExpireMs[0], 4);
+}
+
+/**
+  * @brief  STOPһ룺ĲһĲͶ
+  */
+static void Case_AdvanceKick(void)
+{
+    SoftTimer_t timer;
+
+    Setup();
+    SoftTimer_Create(&timer, Timer_Expired, 0);
+    SoftTimer_Start(&timer, 5, 0);
+
+    SystemTimer_AdvanceMs(62);
+    TEST_CHECK_EQ(EventQueue_IsPending(), 0);
+    Tick();
+    TEST_CHECK_EQ(EventQueue_IsPending(), 1);
+    EventQueue_Dispatch();
+    TEST_CHECK_EQ(ExpireCount, 1);
+    TEST_CHECK_EQ(ExpireMs[0], 63);
+
+    /* ƽûеڶʱͶ */
+    for(uint32_t ms = 0; ms < 50; ms++) {
+        Tick();
+    }
+    TEST_CHECK_EQ(EventCount, 1);
+}
+
+static const Test_CaseTypeDef Cases[] = {
+    { "one_shot", Case_OneShot },
+    { "periodic", Case_Periodic },
+    { "wheel_lap", Case_WheelLap },
+    { "queue_full_retry", Case_QueueFullRetry },
+    { "advance_kick", Case_AdvanceKick },
+};
+
+int main(int argc, char** argv)
+{
+    return Test_Main(argc, argv, Cases, TEST_CASE_COUNT(Cases));
+}
@@ -0,0 +1,62 @@
+//unit_test.h
+
+#ifndef __UNIT_TEST_H
+#define __UNIT_TEST_H
+
+/*
+ * ԵСܣÿԳвѡһУ
+ * CMakeLists.txtΪÿǼһctestԣ֮䲻ģڵľ̬״̬
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+/** @brief  */
+typedef struct {
+    const char* Name;
+    void (*Run)(void);
+} Test_CaseTypeDef;
+
+static uint32_t Test_Failures = 0;
+
+#define TEST_CHECK(cond) do { \
+    if(!(cond)) { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        Test_Failures++; \
+    } \
+} while(0)
+
+#define TEST_CHECK_EQ(actual, expected) do { \
+    long long a_ = (long long)(actual), e_ = (long long)(expected); \
+    if(a_ != e_) { \
+        printf("%s:%d: %s == %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+        Test_Failures++; \
+    } \
+} while(0)
+
+/**
+  * @brief  һʱгȫ
+  * @retval ˳룺0ͨ1ʧܻ
+  */
+static int Test_Main(int argc, char** argv, const Test_CaseTypeDef* cases, uint32_t count)
+{
+    if(argc < 2) {
+        for(uint32_t i = 0; i < count; i++) {
+            printf("%s\n", cases[i].Name);
+        }
+        return 1;
+    }
+    for(uint32_t i = 0; i < count; i++) {
+        if(strcmp(argv[1], cases[i].Name) == 0) {
+            cases[i].Run();
+            printf("%s: %s\n", cases[i].Name, Test_Failures ? "FAILED" : "passed");
+            return Test_Failures ? 1 : 0;
+        }
+    }
+    printf("unknown case %s\n", argv[1]);
+    return 1;
+}
+
+#define TEST_CASE_COUNT(cases)    ((uint32_t)(sizeof(cases) / sizeof((cases)[0])))
+
+#endif /* __UNIT_TEST_H */
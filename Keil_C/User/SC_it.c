@@ -22,6 +22,15 @@
 #include "key_handler.h"
 #include "key.h" 
 #include "system_timer.h" 
+#include "soft_timer.h"
+#include "weight_sensor.h"
+#include "overload_trip.h"
+#include "event_queue.h"
+#include "debug_uart.h"
+#include "supervisor.h"
+#include "buzzer.h"
+#include "scale_manager.h"
+#include "oled.h"
 
 /**************************************Generated by EasyCodeCube*************************************/
 //Forbid editing areas between the labels !!!
@@ -31,40 +40,28 @@
 void INT0_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
-    Key_IRQHandler(KEY_ID_MEASURE);
-    INT_ClearFlag(INT_Channel_0);
+    Key_INTDispatch(KEY_INT_LINES_0);
     /*<Generated by EasyCodeCube end>*/
 }
 
 void INT1_7_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
-    if(INT_GetFlagStatus(INT_Channel_1, INT_Flag_Rising) == SET) {
-        Key_IRQHandler(KEY_ID_TARE);
-        INT_ClearFlag(INT_Channel_1);
-    }
-    
-    if(INT_GetFlagStatus(INT_Channel_2, INT_Flag_Rising) == SET) {
-        Key_IRQHandler(KEY_ID_CALIB);
-        INT_ClearFlag(INT_Channel_2);
-    }
-    
-    if(INT_GetFlagStatus(INT_Channel_3, INT_Flag_Rising) == SET) {
-        Key_IRQHandler(KEY_ID_POWER);
-        INT_ClearFlag(INT_Channel_3);
-    }
+    Key_INTDispatch(KEY_INT_LINES_1_7);
     /*<Generated by EasyCodeCube end>*/
 }
 
 void INT8_11_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
+    Key_INTDispatch(KEY_INT_LINES_8_11);
     /*<Generated by EasyCodeCube end>*/
 }
 
 void INT12_15_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
+    Key_INTDispatch(KEY_INT_LINES_12_15);
     /*<Generated by EasyCodeCube end>*/
 }
 
@@ -109,6 +106,7 @@ void UART0_2_IRQHandler(void)
 void UART0_2_4_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
+    DebugUart_IRQHandler();
     /*<Generated by EasyCodeCube end>*/
 }
 #endif
@@ -118,12 +116,9 @@ void UART0_2_4_IRQHandler(void)
 void BTM_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
-    extern SystemTimer_t systemTimer;
-    
     if(BTM_GetFlagStatus(BTM, BTM_FLAG_IF) == SET) {
-        systemTimer.msCounter += 63;
-        
         BTM_ClearFlag(BTM, BTM_FLAG_IF);
+        EventQueue_Post(EVENT_BTM_TICK, 0, 0);
     }
     /*<Generated by EasyCodeCube end>*/
 }
@@ -132,6 +127,9 @@ void BTM_IRQHandler(void)
 void DMA0_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
+#if DISPLAY_TYPE == DISPLAY_GRAPHIC
+    Oled_DMAIRQHandler();
+#endif
     /*<Generated by EasyCodeCube end>*/
 }
 
@@ -264,6 +262,7 @@ void LEDPWM_IRQHandler(void)
 void ADC_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
+    WeightSensor_ADC_IRQHandler();
     /*<Generated by EasyCodeCube end>*/
 }
 
@@ -282,6 +281,7 @@ void CMP3_IRQHandler(void)
 void CMP_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
+    OverloadTrip_IRQHandler();
     /*<Generated by EasyCodeCube end>*/
 }
 
@@ -289,6 +289,12 @@ void CMP_IRQHandler(void)
 void SysTick_IRQHandler(void)
 {
     /*<Generated by EasyCodeCube begin>*/
+    SC_IncTick();                      // SC_Delayʱ
+    SystemTimer_SysTick_IRQHandler();  // ϵͳ/΢ʱ
+    SoftTimer_SysTickHandler();        // ʱڼ飨еʱͶ¼
+    Supervisor_SysTickHandler();       // ѭʱ¼
+    Key_SysTickHandler();              // ɨ裨аʱ
+    Buzzer_TimerHandler();             // 򣨲ʱ
     /*<Generated by EasyCodeCube end>*/
 }
 
@@ -26,6 +26,9 @@
 #include "scale_manager.h"
 #include "system_timer.h"
 #include "key_handler.h"
+#include "batch_controller.h"
+#include "event_queue.h"
+#include "mem_monitor.h"
 
 /**************************************Generated by EasyCodeCube*************************************/
 //Forbid editing areas between the labels !!!
@@ -34,9 +37,19 @@
 
 /* ϵͳò */
 const float OVERWEIGHT_LIMIT = 1000.0f;        // 1kg
+const float OVERWEIGHT_HYSTERESIS = 20.0f;     // ؽز20g
+const uint32_t OVERWEIGHT_DWELL_TIME = 1000;   // ش/Сפ1(ms)
+const uint8_t OVERWEIGHT_LATCH = 1;            // ر棬谴ȷ
 const uint32_t OVERWEIGHT_CHECK_FREQ = 500;    // 500msһ
 const float ACTIVITY_THRESHOLD = 5.0f;         // 5gֵ
 const uint32_t INACTIVITY_TIMEOUT = 60000;     // 60޲ʱ(ms)
+const uint32_t STABLE_TIME = 1000;             // ȶжʱ1(ms)
+const int32_t DISPLAY_ZERO_BAND = 500;         // ָʾΧ0.5g(mg)
+const uint8_t DISPLAY_DIVISION_STEP = 1;       // ʾֶϵ1/2/5g0.1gkg1g
+const uint8_t DISPLAY_HYSTERESIS = 75;         // ʾͻأ仯ֶȵ75%Ÿʾ
+const uint8_t LED_BRIGHTNESS_ACTIVE = 80;      // LEDܹ(%)
+const uint8_t LED_BRIGHTNESS_STANDBY = 10;     // LEDܴ(%)
+const float BATCH_TARGET_WEIGHT = 500.0f;      // װĬĿ500g޸ģ
 
 /**
   * @brief This function implements main function.
@@ -47,6 +60,7 @@ int main(void)
 {
     /*<Generated by EasyCodeCube begin>*/
     /*<UserCodeStart>*//*<SinOne-Tag><36>*/
+    MemMonitor_PaintStack();   // ջ䣬ͳջʹ÷ֵ
     IcResourceInit();
     Application_Init();
     /*<UserCodeEnd>*//*<SinOne-Tag><36>*/
@@ -56,20 +70,11 @@ int main(void)
     {
         /*<UserCodeStart>*//*<SinOne-Tag><14>*/
         /***User program***/
-        // ʱ
-        SystemTimer_Update();
+        // 1. ַжͶݵ¼Ѻȴڣ
+        EventQueue_Dispatch();
         
-        // 1. ʾ
-        UpdateWeightDisplay();
-        
-        // 2. ʵʱؼ
-        OverweightCheck_RealTime();
-        
-        // 3. 仯
-        CheckWeightActivity();
-        
-        // 4. 60޲ʱ
-        CheckInactivityTimeout();
+        // 2. ִеڵ񣨵ӳ״̬װ¼ʱIDLE
+        Scheduler_Run();
         /*<UserCodeEnd>*//*<SinOne-Tag><14>*/
         /*<Begin-Inserted by EasyCodeCube for Condition>*/
     }